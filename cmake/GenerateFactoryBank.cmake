@@ -0,0 +1,59 @@
+# converts the factory bank from Real Major text to a C++ header
+# usage: cmake -DINPUT=factory.realmajor -DOUTPUT=factory_bank_data.h -P GenerateFactoryBank.cmake
+
+file(READ "${INPUT}" text)
+string(REGEX MATCHALL "\\[[^]]*\\]" frames "${text}")
+
+foreach(nth RANGE 99)
+  set(slot_${nth} "")
+endforeach()
+
+foreach(frame ${frames})
+  string(REGEX REPLACE "[ \t\r\n]+" " " frame "${frame}")
+  # [240, <612 bytes>, <checksum>, 247, 0]
+  if(NOT frame MATCHES "^\\[ ?240, (.*), [0-9]+, 247, 0 ?\\]$")
+    message(FATAL_ERROR "Invalid frame in ${INPUT}")
+  endif()
+  set(bytes "${CMAKE_MATCH_1}")
+  string(REPLACE ", " ";" byte_list "${bytes}")
+  list(LENGTH byte_list byte_count)
+  if(NOT byte_count EQUAL 612)
+    message(FATAL_ERROR "Invalid frame in ${INPUT}: ${byte_count} data bytes instead of 612")
+  endif()
+  set(byte "[0-9]+, ")
+  if(NOT bytes MATCHES "^${byte}${byte}${byte}${byte}${byte}${byte}([0-9]+), ([0-9]+),")
+    message(FATAL_ERROR "Invalid frame in ${INPUT}")
+  endif()
+  # the patch number, as decoded by Patch::patch_number()
+  math(EXPR nth "((${CMAKE_MATCH_2} & 1) << 7 | (${CMAKE_MATCH_1} & 127)) - 101")
+  if(nth LESS 0)
+    set(nth 0)
+  elseif(nth GREATER 99)
+    set(nth 99)
+  endif()
+  set(slot_${nth} "${bytes}")
+endforeach()
+
+set(data "")
+set(used "")
+foreach(nth RANGE 99)
+  if(slot_${nth} STREQUAL "")
+    string(APPEND data "    {},\n")
+    string(APPEND used "false, ")
+  else()
+    string(APPEND data "    {${slot_${nth}}},\n")
+    string(APPEND used "true, ")
+  endif()
+endforeach()
+
+file(WRITE "${OUTPUT}.tmp"
+  "// generated from factory.realmajor, do not edit\n"
+  "#pragma once\n"
+  "#include <stdint.h>\n"
+  "\n"
+  "static constexpr bool factory_bank_used[100] = {${used}};\n"
+  "\n"
+  "static constexpr uint8_t factory_bank_data[100][612] = {\n"
+  "${data}"
+  "};\n")
+file(RENAME "${OUTPUT}.tmp" "${OUTPUT}")
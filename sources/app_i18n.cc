@@ -4,58 +4,121 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #include "app_i18n.h"
-#include <stdexcept>
+#include <charconv>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+#include <assert.h>
 
-#if !defined(_WIN32)
-int vsscanf_l(const char *str, const char *format, locale_t locale, va_list ap)
-{
-    locale_t oldloc = uselocale(locale);
-    if (!oldloc)
-        throw std::runtime_error("cannot set the thread locale");
-    int ret = vsscanf(str, format, ap);
-    if (!uselocale(oldloc))
-        throw std::runtime_error("cannot restore the thread locale");
-    return ret;
-}
+// the numbers are made of integer parts, which std::from_chars and
+// std::to_chars convert everywhere, unlike their floating point versions
 
-int sscanf_l(const char *str, const char *format, locale_t locale, ...)
-{
-    va_list ap;
-    va_start(ap, locale);
-    int ret = vsscanf_l(str, format, locale, ap);
-    va_end(ap);
-    return ret;
-}
-#endif
+static const double powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+    1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+    1e20, 1e21, 1e22,
+};
 
-#if defined(_WIN32)  // for msvcrt compatibility
-int vsscanf_lc(const char *str, const char *format, const char *locale, va_list ap)
+const char *parse_decimal(const char *first, const char *last, double &value)
 {
-    const char *oldlocale = setlocale(LC_ALL, nullptr);
-    errno = 0;
-    if (!setlocale(LC_ALL, locale) && errno != 0)
-        throw std::runtime_error("cannot set the current locale");
-    int ret = vsscanf(str, format, ap);
-    errno = 0;
-    if (!setlocale(LC_ALL, oldlocale) && errno != 0)
-        throw std::runtime_error("cannot set the current locale");
-    return ret;
+    const char *p = first;
+    bool negative = p != last && *p == '-';
+    p += negative;
+
+    unsigned long long mantissa = 0;
+    std::from_chars_result r = std::from_chars(p, last, mantissa);
+    bool has_digits = r.ec == std::errc();
+    if (!has_digits && r.ptr != p)
+        return nullptr;
+    p = r.ptr;
+
+    // the digits of the fraction extend the mantissa while it is exact in
+    // a double, and the digits past this precision are truncated: the value
+    // is the correctly rounded quotient of the digits kept, which is not
+    // what strtod gives for the inputs longer than this
+    const unsigned long long max_exact = 1ull << 53;
+    unsigned decimals = 0;
+    if (p != last && *p == '.') {
+        ++p;
+        for (; p != last && *p >= '0' && *p <= '9'; ++p, has_digits = true) {
+            if (mantissa <= (max_exact - 9) / 10 &&
+                decimals + 1 < sizeof(powers_of_ten) / sizeof(double))
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                ++decimals;
+            }
+        }
+    }
+
+    if (!has_digits)
+        return nullptr;
+
+    double v = (double)mantissa / powers_of_ten[decimals];
+    value = negative ? -v : v;
+    return p;
 }
-#else
-int vsscanf_lc(const char *str, const char *format, const char *locale, va_list ap)
+
+// printf for the values which the integer conversion cannot represent
+// exactly, with the decimal point of the locale replaced
+static std::string format_fixed_printf(double value, unsigned decimals)
 {
-    locale_u loc(createlocale(LC_ALL, "C"));
-    if (!loc)
-        throw std::runtime_error("cannot create the C locale");
-    return vsscanf_l(str, format, loc.get(), ap);
+    int length = snprintf(nullptr, 0, "%.*f", (int)decimals, value);
+    if (length <= 0)
+        return std::string();
+    std::vector<char> buf(length + 1);
+    snprintf(buf.data(), buf.size(), "%.*f", (int)decimals, value);
+
+    std::string text(buf.data(), length);
+    if (decimals > 0 && text.size() > decimals) {
+        size_t fraction = text.size() - decimals;
+        size_t point = text.find_first_not_of("-0123456789");
+        if (point != std::string::npos && point < fraction)
+            text.replace(point, fraction - point, ".");
+    }
+    return text;
 }
-#endif
 
-int sscanf_lc(const char *str, const char *format, const char *locale, ...)
+std::string format_fixed(double value, unsigned decimals)
 {
-    va_list ap;
-    va_start(ap, locale);
-    int ret = vsscanf_lc(str, format, locale, ap);
-    va_end(ap);
-    return ret;
+    assert(decimals < sizeof(powers_of_ten) / sizeof(double));
+
+    if (isnan(value))
+        return "nan";
+    if (isinf(value))
+        return (value < 0) ? "-inf" : "inf";
+
+    // rounds like printf, after the exact product and to even on ties
+    double p = powers_of_ten[decimals];
+    double scaled = fabs(value) * p;
+    // past 2^53 the product has lost the digits of the fraction
+    if (!(scaled < 9007199254740992.0))
+        return format_fixed_printf(value, decimals);
+    double error = fma(fabs(value), p, -scaled);
+    double whole = floor(scaled);
+    double fraction = scaled - whole;
+    bool up = fraction > 0.5 || (fraction == 0.5 &&
+        (error > 0 || (error == 0 && fmod(whole, 2.0) != 0)));
+    unsigned long long magnitude = (unsigned long long)whole + up;
+    // printf keeps the sign of negatives which round to zero, as "-0.0"
+    bool negative = signbit(value);
+
+    char buf[32];
+    char *end = std::to_chars(buf, buf + sizeof(buf), magnitude).ptr;
+
+    // at least one digit goes before the point
+    std::string digits(buf, end);
+    if (digits.size() <= decimals)
+        digits.insert(0, decimals + 1 - digits.size(), '0');
+    size_t integral = digits.size() - decimals;
+
+    std::string text;
+    text.reserve(digits.size() + 2);
+    if (negative)
+        text.push_back('-');
+    text.append(digits, 0, integral);
+    if (decimals > 0) {
+        text.push_back('.');
+        text.append(digits, integral, decimals);
+    }
+    return text;
 }
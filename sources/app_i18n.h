@@ -16,39 +16,14 @@
 
 // Locale
 #include <locale.h>
-#if defined(__APPLE__)
-#include <xlocale.h>
-#endif
-
-#if defined(_WIN32)
-typedef _locale_t locale_t;
-inline void freelocale(locale_t x) { _free_locale(x); }
-inline locale_t createlocale(int cat, const char *loc) { return _create_locale(cat, loc); }
-#else
-inline locale_t createlocale(int cat, const char *loc) { return newlocale(cat, loc, nullptr); }
-#endif
-
-// Locale RAII
-#include <memory>
-#include <type_traits>
 
-struct Locale_Deleter {
-    void operator()(locale_t x) const { freelocale(x); }
-};
-typedef std::unique_ptr<std::remove_pointer<locale_t>::type, Locale_Deleter> locale_u;
-
-// Locale-independent formatting
-#include <stdio.h>
-#include <stdarg.h>
-
-
-#if !defined(_WIN32)
-int vsscanf_l(const char *str, const char *format, locale_t locale, va_list ap);
-int sscanf_l(const char *str, const char *format, locale_t locale, ...);
-#else
-#define vsscanf_l _vsscanf_l
-#define sscanf_l _sscanf_l
-#endif
+// Locale-independent numbers, in the decimal formats of the parameters
+#include <string>
+#include <stddef.h>
 
-int vsscanf_lc(const char *str, const char *format, const char *locale, va_list ap);
-int sscanf_lc(const char *str, const char *format, const char *locale, ...);
+// reads a decimal number such as "-12.5" at the start of the range, and
+// returns the end of it, or null if there is none; the digits beyond the
+// precision of a double are truncated
+const char *parse_decimal(const char *first, const char *last, double &value);
+// formats a number with a fixed count of decimals, as "%.*f" in C locale
+std::string format_fixed(double value, unsigned decimals);
@@ -0,0 +1,44 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "model/patch_loader.h"
+#include "model/patch.h"
+#include "utility/misc.h"
+#include <FL/fl_utf8.h>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+
+// measures the loading of a RealMajor bank, by default the factory bank
+int main(int argc, char *argv[])
+{
+    const char *filename = (argc > 1) ? argv[1] : FACTORY_BANK_FILE;
+    unsigned iterations = (argc > 2) ? (unsigned)atoi(argv[2]) : 1000;
+
+    FILE_u fh(fl_fopen(filename, "rb"));
+    std::vector<uint8_t> data;
+    if (!fh || !read_entire_file(fh.get(), 1024 * 1024, data)) {
+        fprintf(stderr, "Could not read the bank file: %s\n", filename);
+        return 1;
+    }
+
+    std::unique_ptr<Patch_Bank> pbank(new Patch_Bank);
+    if (!Patch_Loader::load_realmajor_bank(data.data(), data.size(), *pbank)) {
+        fprintf(stderr, "Could not load the bank file: %s\n", filename);
+        return 1;
+    }
+
+    typedef std::chrono::steady_clock clock;
+    clock::time_point start = clock::now();
+    for (unsigned i = 0; i < iterations; ++i)
+        Patch_Loader::load_realmajor_bank(data.data(), data.size(), *pbank);
+    std::chrono::duration<double, std::milli> elapsed = clock::now() - start;
+
+    printf("%s: %u loads, %.4f ms per load\n", filename, iterations,
+           elapsed.count() / (iterations ? iterations : 1));
+    return 0;
+}
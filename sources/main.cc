@@ -110,7 +110,9 @@ int main(int argc, char *argv[])
     win.show();
 
     Main_Component &cpt = win.component();
-    if (arg_filename)
+    // a recovered bank is kept over the file of the command line
+    bool recovered = cpt.recover_journal();
+    if (arg_filename && !recovered)
         cpt.load_bank_file(arg_filename);
 
     Fl::run();
@@ -0,0 +1,215 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "bank_file.h"
+#include "patch_writer.h"
+#include "patch_archive.h"
+#include "utility/misc.h"
+#include <FL/fl_utf8.h>
+#include <vector>
+#include <string.h>
+
+static const char redo_magic[8] = {'F', 'M', 'R', 'E', 'D', 'O', '0', '1'};
+
+static uint64_t redo_checksum(const std::vector<uint8_t> &redo)
+{
+    // FNV-1a, of all but the magic and the checksum
+    uint64_t hash = UINT64_C(14695981039346656037);
+    for (size_t i = 8, n = redo.size(); i < n; ++i) {
+        if (i == 24)
+            i += 8;
+        if (i >= n)
+            break;
+        hash = (hash ^ redo[i]) * UINT64_C(1099511628211);
+    }
+    return hash;
+}
+
+void Bank_File::assign(const std::string &filename, int format, Patch_Bank &pbank)
+{
+    this->filename = filename;
+    this->format = format;
+    used = pbank.used;
+    written_ = false;
+    pbank.dirty.reset();
+}
+
+void Bank_File::reset(Patch_Bank &pbank)
+{
+    filename.clear();
+    format = -1;
+    used.reset();
+    written_ = false;
+    pbank.dirty.set();
+}
+
+bool Bank_File::save(const std::string &filename, int format, Patch_Bank &pbank)
+{
+    bool same_file = written_ && filename == this->filename &&
+        format == this->format && pbank.used == used;
+
+    // sysex records have a fixed size, so they can be rewritten in place.
+    // a loaded file may have its records in any order, so it must have been
+    // written here.
+    if (same_file && format == Bank_Format::SystemExclusive && save_in_place(pbank)) {
+        pbank.dirty.reset();
+        return true;
+    }
+
+    std::vector<uint8_t> data;
+    switch (format) {
+    case Bank_Format::RealMajor:
+        Patch_Writer::save_realmajor_bank(pbank, data);
+        break;
+    case Bank_Format::SystemExclusive:
+        Patch_Writer::save_sysex_bank(pbank, data);
+        break;
+    case Bank_Format::Library:
+        Patch_Archive::save_bank(pbank, data);
+        break;
+    case Bank_Format::StandardMidiFile:
+        Patch_Writer::save_midifile_bank(pbank, data);
+        break;
+    default:
+        return false;
+    }
+
+    // a redo of an earlier save must not apply to the new file. the removal
+    // is made durable by the replacement.
+    fl_unlink(redo_filename(filename).c_str());
+
+    if (!write_file_atomically(filename, data.data(), data.size()))
+        return false;
+
+    assign(filename, format, pbank);
+    written_ = true;
+    return true;
+}
+
+bool Bank_File::save_in_place(const Patch_Bank &pbank)
+{
+    std::bitset<Patch_Bank::max_count> dirty = pbank.dirty & pbank.used;
+    if (dirty.none())
+        return true;
+
+    FILE_u fh(fl_fopen(filename.c_str(), "r+b"));
+    if (!fh)
+        return false;
+
+    std::vector<uint8_t> record;
+    Patch_Writer::save_sysex_patch(Patch::create_empty(), record);
+    size_t record_size = record.size();
+    uint64_t file_size = used.count() * record_size;
+
+    // the file must be as it was saved, otherwise write it whole
+    if (fseek(fh.get(), 0, SEEK_END) != 0 || ftell(fh.get()) != (long)file_size)
+        return false;
+
+    std::vector<uint8_t> redo(redo_header_size);
+    redo.reserve(redo_header_size + dirty.count() * (8 + record_size));
+    memcpy(&redo[0], redo_magic, sizeof(redo_magic));
+    store_u32le(&redo[8], dirty.count());
+    store_u32le(&redo[12], record_size);
+    store_u64le(&redo[16], file_size);
+
+    for (unsigned i = 0, rank = 0; i < Patch_Bank::max_count; ++i) {
+        if (!pbank.used[i])
+            continue;
+        if (dirty[i]) {
+            Patch_Writer::save_sysex_patch(pbank.slot[i], record);
+            if (record.size() != record_size)
+                return false;
+            uint8_t offset[8];
+            store_u64le(offset, rank * record_size);
+            redo.insert(redo.end(), offset, offset + 8);
+            redo.insert(redo.end(), record.begin(), record.end());
+        }
+        ++rank;
+    }
+    store_u64le(&redo[24], redo_checksum(redo));
+
+    // the redo is durable before the bank is touched
+    std::string redoname = redo_filename(filename);
+    FILE_u rh(fl_fopen(redoname.c_str(), "wb"));
+    if (!rh)
+        return false;
+    bool success = fwrite(redo.data(), 1, redo.size(), rh.get()) == redo.size() && sync_file(rh.get());
+    success = fclose(rh.release()) == 0 && success;
+    if (!success || !sync_file_directory(redoname)) {
+        fl_unlink(redoname.c_str());
+        return false;
+    }
+
+    // past this point, an interrupted save is completed by recover()
+    success = apply_redo(fh.get(), redo);
+    success = fclose(fh.release()) == 0 && success;
+    if (success)
+        fl_unlink(redoname.c_str());
+    return success;
+}
+
+std::string Bank_File::redo_filename(const std::string &filename)
+{
+    return filename + ".redo";
+}
+
+bool Bank_File::apply_redo(FILE *fh, const std::vector<uint8_t> &redo)
+{
+    size_t count = load_u32le(&redo[8]);
+    size_t record_size = load_u32le(&redo[12]);
+    const uint8_t *entry = &redo[redo_header_size];
+
+    for (size_t i = 0; i < count; ++i, entry += 8 + record_size) {
+        uint64_t offset = load_u64le(entry);
+        if (fseek(fh, (long)offset, SEEK_SET) != 0 ||
+            fwrite(entry + 8, 1, record_size, fh) != record_size)
+            return false;
+    }
+    return sync_file(fh);
+}
+
+bool Bank_File::recover(const std::string &filename)
+{
+    std::string redoname = redo_filename(filename);
+    FILE_u rh(fl_fopen(redoname.c_str(), "rb"));
+    if (!rh)
+        return true;
+
+    std::vector<uint8_t> redo;
+    bool readable = read_entire_file(rh.get(), 16 * 1024 * 1024, redo);
+    rh.reset();
+    if (!readable)
+        return false;
+
+    // a redo which is incomplete was cut before the bank was touched
+    bool valid = redo.size() >= redo_header_size &&
+        memcmp(redo.data(), redo_magic, sizeof(redo_magic)) == 0 &&
+        load_u64le(&redo[24]) == redo_checksum(redo);
+    if (valid) {
+        uint64_t count = load_u32le(&redo[8]);
+        uint64_t record_size = load_u32le(&redo[12]);
+        valid = redo.size() == redo_header_size + count * (8 + record_size);
+        for (size_t i = 0; valid && i < count; ++i) {
+            uint64_t offset = load_u64le(&redo[redo_header_size + i * (8 + record_size)]);
+            valid = offset + record_size <= load_u64le(&redo[16]);
+        }
+    }
+
+    if (valid) {
+        FILE_u fh(fl_fopen(filename.c_str(), "r+b"));
+        if (!fh || fseek(fh.get(), 0, SEEK_END) != 0)
+            return false;
+        // of another size, the file was replaced since, and the redo is stale
+        if ((uint64_t)ftell(fh.get()) == load_u64le(&redo[16])) {
+            bool success = apply_redo(fh.get(), redo);
+            success = fclose(fh.release()) == 0 && success;
+            if (!success)
+                return false;
+        }
+    }
+
+    fl_unlink(redoname.c_str());
+    return true;
+}
@@ -0,0 +1,49 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include "patch.h"
+#include <string>
+#include <vector>
+#include <bitset>
+#include <stdio.h>
+
+// file which a bank was last loaded from or saved to, as it is on disk
+//
+// an in-place save first writes its records to a redo file next to the bank,
+// "<file>.redo", which completes the save if it is interrupted.
+// layout, in little-endian order:
+//   magic "FMREDO01", u32 record count, u32 record size, u64 file size,
+//   u64 FNV-1a of the rest of the header and of the entries
+//   entries: u64 offset, record
+class Bank_File {
+public:
+    std::string filename;
+    int format = -1;
+    std::bitset<Patch_Bank::max_count> used;
+
+    // associates the file with the bank, which is clean afterwards
+    void assign(const std::string &filename, int format, Patch_Bank &pbank);
+    // dissociates the file, for a bank which replaced the previous
+    void reset(Patch_Bank &pbank);
+
+    // saves the bank, by rewriting the dirty records of the file in place
+    // when the format permits, or else by replacing the file whole
+    bool save(const std::string &filename, int format, Patch_Bank &pbank);
+
+    // completes an in-place save which was interrupted, before a load
+    static bool recover(const std::string &filename);
+
+private:
+    enum { redo_header_size = 32 };
+
+    static std::string redo_filename(const std::string &filename);
+    static bool apply_redo(FILE *fh, const std::vector<uint8_t> &redo);
+    bool save_in_place(const Patch_Bank &pbank);
+
+private:
+    // whether the file was written here, with its records in slot order
+    bool written_ = false;
+};
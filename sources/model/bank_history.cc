@@ -0,0 +1,337 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "bank_history.h"
+#include <FL/fl_utf8.h>
+#include <algorithm>
+#include <memory>
+#include <string.h>
+
+static const char pack_magic[8] = {'F', 'M', 'P', 'A', 'C', 'K', '0', '1'};
+
+std::string Bank_History::directory_for(const std::string &bank_filename)
+{
+    return bank_filename + ".history";
+}
+
+static FILE *open_history_file(const std::string &filename, bool create)
+{
+    FILE *fh = fl_fopen(filename.c_str(), "r+b");
+    if (!fh && create) {
+        // create it empty, then reopen for update
+        FILE_u fh_new(fl_fopen(filename.c_str(), "wb"));
+        if (fh_new && fclose(fh_new.release()) == 0)
+            fh = fl_fopen(filename.c_str(), "r+b");
+    }
+    return fh;
+}
+
+static bool file_size(FILE *fh, size_t &size)
+{
+    if (fseek(fh, 0, SEEK_END) != 0)
+        return false;
+    long off = ftell(fh);
+    if (off < 0)
+        return false;
+    size = off;
+    return true;
+}
+
+static bool read_at(FILE *fh, size_t offset, void *data, size_t size)
+{
+    return fseek(fh, offset, SEEK_SET) == 0 && fread(data, 1, size, fh) == size;
+}
+
+static bool write_at(FILE *fh, size_t offset, const void *data, size_t size)
+{
+    return fseek(fh, offset, SEEK_SET) == 0 && fwrite(data, 1, size, fh) == size;
+}
+
+bool Bank_History::open(const std::string &dirname, bool create)
+{
+    close();
+
+    if (create)
+        fl_mkdir(dirname.c_str(), 0777);
+
+    pack_.reset(open_history_file(dirname + "/objects.pack", create));
+    idx_.reset(open_history_file(dirname + "/objects.idx", create));
+    log_.reset(open_history_file(dirname + "/revisions.log", create));
+
+    size_t pack_size, idx_size, log_size;
+    if (!pack_ || !idx_ || !log_ ||
+        !file_size(pack_.get(), pack_size) || !file_size(idx_.get(), idx_size) ||
+        !file_size(log_.get(), log_size))
+    {
+        close();
+        return false;
+    }
+
+    // the baseline is written with the first revision
+    uint8_t header[pack_header_size];
+    has_baseline_ = pack_size >= pack_header_size;
+    if (has_baseline_) {
+        if (!read_at(pack_.get(), 0, header, pack_header_size) ||
+            memcmp(header, pack_magic, sizeof(pack_magic)) != 0)
+        {
+            close();
+            return false;
+        }
+        Patch baseline;
+        memcpy(baseline.raw_data, &header[sizeof(pack_magic)], sizeof(baseline.raw_data));
+        delta_ = Patch_Delta(baseline);
+    }
+
+    // a record which is incomplete is ignored, and overwritten later
+    object_count_ = has_baseline_ ? idx_size / idx_entry_size : 0;
+    revision_count_ = log_size / manifest_size;
+
+    std::unique_ptr<uint8_t[]> entries(new uint8_t[idx_entry_size * object_count_]);
+    if (!read_at(idx_.get(), 0, entries.get(), idx_entry_size * object_count_)) {
+        close();
+        return false;
+    }
+    offsets_.resize(object_count_);
+    for (size_t i = 0; i < object_count_; ++i)
+        offsets_[i] = load_u64le(&entries[idx_entry_size * i + 8]);
+
+    pack_end_ = pack_header_size;
+    while (object_count_ > 0) {
+        uint8_t record[Patch_Delta::max_record_size];
+        size_t size;
+        uint64_t offset = offsets_[object_count_ - 1];
+        if (offset + Patch_Delta::bitmap_size <= pack_size && read_record(offset, record, size) &&
+            offset + size <= pack_size)
+        {
+            pack_end_ = offset + size;
+            break;
+        }
+        --object_count_;
+    }
+    offsets_.resize(object_count_);
+
+    objects_.reserve(object_count_);
+    for (size_t i = 0; i < object_count_; ++i)
+        objects_.emplace(load_u64le(&entries[idx_entry_size * i]), i);
+
+    // a revision which refers to objects lost in a crash is dropped, or
+    // else the new objects would take the ids which it refers to
+    for (Object_Id &id : last_)
+        id = no_object;
+    while (revision_count_ > 0) {
+        uint8_t manifest[manifest_size];
+        if (!read_at(log_.get(), (revision_count_ - 1) * manifest_size, manifest, manifest_size)) {
+            close();
+            return false;
+        }
+        bool complete = true;
+        for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+            last_[i] = load_u32le(&manifest[8 + 4 * i]);
+            complete = complete && (last_[i] == no_object || last_[i] < object_count_);
+        }
+        if (complete)
+            break;
+        for (Object_Id &id : last_)
+            id = no_object;
+        --revision_count_;
+    }
+
+    // what was dropped is cut, so that it never comes back
+    if ((idx_size != idx_entry_size * object_count_ &&
+         !truncate_file(idx_.get(), idx_entry_size * object_count_)) ||
+        (log_size != manifest_size * revision_count_ &&
+         !truncate_file(log_.get(), manifest_size * revision_count_)))
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void Bank_History::close()
+{
+    pack_.reset();
+    idx_.reset();
+    log_.reset();
+    object_count_ = 0;
+    offsets_.clear();
+    pack_end_ = 0;
+    has_baseline_ = false;
+    revision_count_ = 0;
+    objects_.clear();
+}
+
+bool Bank_History::revision_time(size_t revision, int64_t &time)
+{
+    uint8_t data[8];
+    if (!log_ || revision >= revision_count_ ||
+        !read_at(log_.get(), revision * manifest_size, data, sizeof(data)))
+        return false;
+    time = (int64_t)load_u64le(data);
+    return true;
+}
+
+bool Bank_History::commit(const Patch_Bank &pbank, int64_t time)
+{
+    if (!log_)
+        return false;
+
+    if (!has_baseline_ && !write_baseline(pbank)) {
+        close();
+        return false;
+    }
+
+    Object_Id ids[Patch_Bank::max_count];
+    bool added = false;
+
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+        if (!pbank.used[i]) {
+            ids[i] = no_object;
+            continue;
+        }
+
+        Patch pat = pbank.slot[i];
+        pat.patch_number(0);
+        uint64_t hash = pat.hash();
+
+        Object_Id id = find_object(pat, hash, last_[i]);
+        if (id == no_object) {
+            id = object_count_;
+            uint8_t record[Patch_Delta::max_record_size];
+            size_t size = delta_.encode(pat, record);
+            uint8_t entry[idx_entry_size];
+            store_u64le(entry, hash);
+            store_u64le(entry + 8, pack_end_);
+            if (!write_at(pack_.get(), pack_end_, record, size) ||
+                !write_at(idx_.get(), id * idx_entry_size, entry, idx_entry_size))
+            {
+                close();
+                return false;
+            }
+            objects_.emplace(hash, id);
+            offsets_.push_back(pack_end_);
+            pack_end_ += size;
+            ++object_count_;
+            added = true;
+        }
+        ids[i] = id;
+    }
+
+    if (!added && revision_count_ > 0 && memcmp(ids, last_, sizeof(ids)) == 0)
+        return true;
+
+    // objects must be on disk before the revision which refers to them
+    if (!sync_file(pack_.get()) || !sync_file(idx_.get())) {
+        close();
+        return false;
+    }
+
+    uint8_t manifest[manifest_size];
+    store_u64le(manifest, (uint64_t)time);
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i)
+        store_u32le(&manifest[8 + 4 * i], ids[i]);
+
+    if (!write_at(log_.get(), revision_count_ * manifest_size, manifest, manifest_size) ||
+        !sync_file(log_.get()))
+    {
+        close();
+        return false;
+    }
+
+    ++revision_count_;
+    memcpy(last_, ids, sizeof(ids));
+    return true;
+}
+
+bool Bank_History::checkout(size_t revision, Patch_Bank &pbank)
+{
+    uint8_t manifest[manifest_size];
+    if (!log_ || revision >= revision_count_ ||
+        !read_at(log_.get(), revision * manifest_size, manifest, manifest_size))
+        return false;
+
+    std::unique_ptr<Patch_Bank> pbank_tmp(new Patch_Bank);
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+        Object_Id id = load_u32le(&manifest[8 + 4 * i]);
+        if (id == no_object)
+            continue;
+        Patch &pat = pbank_tmp->slot[i];
+        if (!read_object(id, pat))
+            return false;
+        pat.patch_number(i);
+        pbank_tmp->used[i] = true;
+    }
+
+    pbank = *pbank_tmp;
+    return true;
+}
+
+bool Bank_History::read_object(Object_Id id, Patch &pat)
+{
+    uint8_t record[Patch_Delta::max_record_size];
+    size_t size;
+    if (id >= object_count_ || !read_record(offsets_[id], record, size))
+        return false;
+    delta_.decode(record, pat);
+    return true;
+}
+
+bool Bank_History::read_record(uint64_t offset, uint8_t *record, size_t &size)
+{
+    if (!read_at(pack_.get(), offset, record, Patch_Delta::bitmap_size))
+        return false;
+    size = Patch_Delta::record_size(record);
+    return size != 0 &&
+        read_at(pack_.get(), offset + Patch_Delta::bitmap_size,
+                record + Patch_Delta::bitmap_size, size - Patch_Delta::bitmap_size);
+}
+
+bool Bank_History::write_baseline(const Patch_Bank &pbank)
+{
+    std::vector<Patch> pats;
+    pats.reserve(Patch_Bank::max_count);
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+        if (pbank.used[i]) {
+            pats.push_back(pbank.slot[i]);
+            pats.back().patch_number(0);
+        }
+    }
+    Patch baseline = Patch_Delta::mode_baseline(pats.data(), pats.size());
+
+    uint8_t header[pack_header_size];
+    memcpy(header, pack_magic, sizeof(pack_magic));
+    memcpy(&header[sizeof(pack_magic)], baseline.raw_data, sizeof(baseline.raw_data));
+    if (!write_at(pack_.get(), 0, header, pack_header_size))
+        return false;
+
+    delta_ = Patch_Delta(baseline);
+    pack_end_ = pack_header_size;
+    has_baseline_ = true;
+    return true;
+}
+
+Bank_History::Object_Id Bank_History::find_object(const Patch &pat, uint64_t hash, Object_Id hint)
+{
+    auto range = objects_.equal_range(hash);
+    auto same = [this, &pat](Object_Id id) -> bool {
+                    Patch other;
+                    return read_object(id, other) &&
+                        memcmp(other.raw_data, pat.raw_data, sizeof(pat.raw_data)) == 0;
+                };
+
+    // the object of the last revision is the likely one, tried first
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == hint && same(hint))
+            return hint;
+    }
+
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second != hint && same(it->second))
+            return it->second;
+    }
+
+    return no_object;
+}
@@ -0,0 +1,73 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include "patch.h"
+#include "patch_delta.h"
+#include "utility/misc.h"
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+// history of the revisions of a bank, stored in a directory.
+// each distinct patch is written once, and a revision refers to them.
+//
+// files, in little-endian order:
+//   objects.pack: magic "FMPACK01", baseline patch of 612 bytes, then the
+//                 patches as records of Patch_Delta against the baseline,
+//                 with a patch number of 0. the baseline is the most
+//                 frequent value of each word in the first revision.
+//   objects.idx: u64 content hash, u64 pack offset for each record
+//   revisions.log: for each revision, i64 time, then 100 x u32 record
+//                  numbers, where ~0 marks an unused slot
+class Bank_History {
+public:
+    Bank_History() {}
+
+    Bank_History(const Bank_History &) = delete;
+    Bank_History &operator=(const Bank_History &) = delete;
+
+    static std::string directory_for(const std::string &bank_filename);
+
+    // opens the history, creating it if necessary
+    bool open(const std::string &dirname, bool create = true);
+    void close();
+
+    size_t revision_count() const { return revision_count_; }
+    bool revision_time(size_t revision, int64_t &time);
+
+    // appends a revision, unless identical to the last
+    bool commit(const Patch_Bank &pbank, int64_t time);
+    bool checkout(size_t revision, Patch_Bank &pbank);
+
+private:
+    enum {
+        pack_header_size = 8 + sizeof(Patch::raw_data),
+        idx_entry_size = 16,
+        manifest_size = 8 + 4 * Patch_Bank::max_count,
+    };
+    typedef uint32_t Object_Id;
+    static constexpr Object_Id no_object = ~(Object_Id)0;
+
+    bool read_object(Object_Id id, Patch &pat);
+    bool read_record(uint64_t offset, uint8_t *record, size_t &size);
+    bool write_baseline(const Patch_Bank &pbank);
+    Object_Id find_object(const Patch &pat, uint64_t hash, Object_Id hint);
+
+private:
+    FILE_u pack_;
+    FILE_u idx_;
+    FILE_u log_;
+    size_t object_count_ = 0;
+    std::vector<uint64_t> offsets_;
+    uint64_t pack_end_ = 0;
+    bool has_baseline_ = false;
+    Patch_Delta delta_;
+    size_t revision_count_ = 0;
+    std::unordered_multimap<uint64_t, Object_Id> objects_;
+    // objects of the last revision
+    Object_Id last_[Patch_Bank::max_count];
+};
@@ -0,0 +1,224 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "edit_journal.h"
+#include <FL/Fl_Preferences.H>
+#include <FL/fl_utf8.h>
+#include <FL/filename.H>
+#include <chrono>
+#include <memory>
+#include <string.h>
+
+static const char journal_magic[8] = {'F', 'M', 'J', 'R', 'N', 'L', '0', '1'};
+
+Edit_Journal::Edit_Journal()
+{
+    filename_ = claim_filename(lock_);
+    thread_ = std::thread([this]() { run(); });
+}
+
+Edit_Journal::~Edit_Journal()
+{
+    stop();
+}
+
+std::string Edit_Journal::claim_filename(FILE_u &lock)
+{
+    Fl_Preferences prefs(Fl_Preferences::USER, "linuxmao.org", "FreeMajor");
+    char path[FL_PATH_MAX];
+    if (!prefs.getUserdataPath(path, sizeof(path)))
+        return std::string();
+
+    // the first instance keeps the name of a single journal
+    for (unsigned i = 0; i < max_instances; ++i) {
+        std::string filename = std::string(path) + "journal";
+        if (i > 0)
+            filename += "-" + std::to_string(i);
+        filename += ".bin";
+        FILE_u fh(fl_fopen((filename + ".lock").c_str(), "ab"));
+        if (fh && lock_file(fh.get())) {
+            lock = std::move(fh);
+            return filename;
+        }
+    }
+    return std::string();
+}
+
+bool Edit_Journal::recover(const std::string &filename, Patch_Bank &pbank)
+{
+    FILE_u fh(fl_fopen(filename.c_str(), "rb"));
+    std::vector<uint8_t> data;
+    if (!fh || !read_entire_file(fh.get(), 64 * 1024 * 1024, data))
+        return false;
+
+    const size_t snapshot_size = Patch_Bank::max_count * sizeof(Patch::raw_data);
+    if (data.size() < header_size + snapshot_size ||
+        memcmp(data.data(), journal_magic, sizeof(journal_magic)) != 0)
+        return false;
+
+    uint32_t flags = load_u32le(&data[8]);
+    const uint8_t *records = &data[header_size + snapshot_size];
+    // an incomplete record at the end is ignored
+    size_t record_count = (data.size() - header_size - snapshot_size) / record_size;
+
+    if (!(flags & Flag_Unsaved) && record_count == 0)
+        return false;
+
+    std::unique_ptr<Patch_Bank> pbank_tmp(new Patch_Bank);
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+        pbank_tmp->used[i] = (data[16 + i / 8] >> (i % 8)) & 1;
+        memcpy(pbank_tmp->slot[i].raw_data, &data[header_size + i * sizeof(Patch::raw_data)], sizeof(Patch::raw_data));
+    }
+
+    for (size_t i = 0; i < record_count; ++i) {
+        const uint8_t *rec = &records[i * record_size];
+        unsigned kind = rec[0];
+        unsigned slot = rec[1];
+        unsigned word = rec[2] | (rec[3] << 8);
+        if (slot >= Patch_Bank::max_count)
+            break;
+        if (kind == Record_Word && word < sizeof(Patch::raw_data) / 4)
+            memcpy(&pbank_tmp->slot[slot].raw_data[4 * word], &rec[4], 4);
+        else if (kind == Record_Used)
+            pbank_tmp->used[slot] = rec[4] != 0;
+        else
+            break;
+    }
+
+    pbank = *pbank_tmp;
+    pbank.dirty.set();
+    return true;
+}
+
+void Edit_Journal::rebase(const Patch_Bank &pbank, bool unsaved)
+{
+    const size_t snapshot_size = Patch_Bank::max_count * sizeof(Patch::raw_data);
+    std::vector<uint8_t> snapshot(header_size + snapshot_size);
+
+    memcpy(&snapshot[0], journal_magic, sizeof(journal_magic));
+    store_u32le(&snapshot[8], unsaved ? Flag_Unsaved : 0);
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+        snapshot[16 + i / 8] |= pbank.used[i] << (i % 8);
+        memcpy(&snapshot[header_size + i * sizeof(Patch::raw_data)], pbank.slot[i].raw_data, sizeof(Patch::raw_data));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_snapshot_ = std::move(snapshot);
+    // the earlier records are superseded
+    pending_records_.clear();
+    based_ = true;
+    cond_.notify_one();
+}
+
+void Edit_Journal::write_patch(unsigned slot, const Patch &before, const Patch &after)
+{
+    for (unsigned i = 0; i < sizeof(Patch::raw_data) / 4; ++i) {
+        const uint8_t *word = &after.raw_data[4 * i];
+        if (memcmp(&before.raw_data[4 * i], word, 4) != 0)
+            append(Record_Word, slot, i, word);
+    }
+}
+
+void Edit_Journal::write_used(unsigned slot, bool used)
+{
+    uint8_t value[4] = {used, 0, 0, 0};
+    append(Record_Used, slot, 0, value);
+}
+
+void Edit_Journal::discard()
+{
+    stop();
+    if (!filename_.empty())
+        fl_unlink(filename_.c_str());
+}
+
+void Edit_Journal::append(Record_Kind kind, unsigned slot, unsigned word, const uint8_t value[4])
+{
+    uint8_t rec[record_size] = {(uint8_t)kind, (uint8_t)slot, (uint8_t)(word & 0xff), (uint8_t)(word >> 8)};
+    memcpy(&rec[4], value, 4);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!based_ || quit_)
+        return;
+    bool was_empty = pending_records_.empty();
+    pending_records_.insert(pending_records_.end(), rec, rec + record_size);
+    if (was_empty)
+        cond_.notify_one();
+}
+
+void Edit_Journal::stop()
+{
+    if (!thread_.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+        cond_.notify_one();
+    }
+    thread_.join();
+}
+
+void Edit_Journal::run()
+{
+    std::vector<uint8_t> snapshot;
+    std::vector<uint8_t> records;
+    bool unsynced = false;
+    typedef std::chrono::steady_clock clock;
+    const clock::duration sync_interval = std::chrono::milliseconds(sync_interval_ms);
+    clock::time_point last_sync = clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        // sync the file at intervals, also while the edits keep coming
+        if (unsynced && clock::now() - last_sync >= sync_interval) {
+            lock.unlock();
+            if (fh_)
+                sync_file(fh_.get());
+            unsynced = false;
+            last_sync = clock::now();
+            lock.lock();
+        }
+
+        // wait for data, or for the time of the next sync
+        if (pending_snapshot_.empty() && pending_records_.empty() && !quit_) {
+            auto ready = [this]() { return quit_ || !pending_snapshot_.empty() || !pending_records_.empty(); };
+            if (unsynced)
+                cond_.wait_until(lock, last_sync + sync_interval, ready);
+            else
+                cond_.wait(lock, ready);
+            continue;
+        }
+
+        snapshot.swap(pending_snapshot_);
+        records.swap(pending_records_);
+        bool quit = quit_;
+        lock.unlock();
+
+        if (!snapshot.empty()) {
+            fh_.reset(fl_fopen(filename_.c_str(), "wb"));
+            if (fh_)
+                fwrite(snapshot.data(), 1, snapshot.size(), fh_.get());
+            snapshot.clear();
+            unsynced = true;
+        }
+        if (!records.empty()) {
+            if (fh_)
+                fwrite(records.data(), 1, records.size(), fh_.get());
+            records.clear();
+            unsynced = true;
+        }
+        if (fh_)
+            fflush(fh_.get());
+
+        if (quit) {
+            if (fh_ && unsynced)
+                sync_file(fh_.get());
+            fh_.reset();
+            return;
+        }
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,83 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include "patch.h"
+#include "utility/misc.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+// journal of the edits of a bank, which is written in the background,
+// to recover the edits after a crash. each running instance has its own,
+// the first of the journal files which no other instance has locked.
+//
+// layout, in little-endian order:
+//   magic "FMJRNL01", u32 flags, u32 reserved, used slots (16 bytes),
+//   snapshot of the bank (100 x 612 bytes)
+//   records of 8 bytes: u8 kind, u8 slot, u16 word, u32 value
+class Edit_Journal {
+public:
+    Edit_Journal();
+    ~Edit_Journal();
+
+    Edit_Journal(const Edit_Journal &) = delete;
+    Edit_Journal &operator=(const Edit_Journal &) = delete;
+
+    const std::string &filename() const { return filename_; }
+
+    // reads the journal of a previous session, if it has unsaved edits
+    static bool recover(const std::string &filename, Patch_Bank &pbank);
+
+    // starts over from a bank, which is unsaved if it differs from its file
+    void rebase(const Patch_Bank &pbank, bool unsaved);
+
+    // records the words of a slot which differ between two versions
+    void write_patch(unsigned slot, const Patch &before, const Patch &after);
+    void write_used(unsigned slot, bool used);
+
+    // stops and removes the journal, when edits need no recovery
+    void discard();
+
+private:
+    enum {
+        header_size = 32,
+        record_size = 8,
+        sync_interval_ms = 1000,
+        max_instances = 16,
+    };
+
+    enum Record_Kind {
+        Record_Word = 1,
+        Record_Used = 2,
+    };
+
+    enum Flag {
+        Flag_Unsaved = 1,
+    };
+
+    static std::string claim_filename(FILE_u &lock);
+    void append(Record_Kind kind, unsigned slot, unsigned word, const uint8_t value[4]);
+    void stop();
+    void run();
+
+private:
+    std::string filename_;
+    // held while the journal is in use
+    FILE_u lock_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool quit_ = false;
+    bool based_ = false;
+    // data waiting to be written, guarded by the mutex
+    std::vector<uint8_t> pending_snapshot_;
+    std::vector<uint8_t> pending_records_;
+    // owned by the thread
+    FILE_u fh_;
+};
@@ -0,0 +1,19 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "factory_bank.h"
+#include "patch.h"
+#include "factory_bank_data.h"  // generated from factory.realmajor
+#include <string.h>
+
+static_assert(sizeof(factory_bank_data[0]) == sizeof(Patch::raw_data), "the factory patches must have the size of a patch");
+
+void Factory_Bank::load(Patch_Bank &pbank)
+{
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+        memcpy(pbank.slot[i].raw_data, factory_bank_data[i], sizeof(Patch::raw_data));
+        pbank.used[i] = factory_bank_used[i];
+    }
+}
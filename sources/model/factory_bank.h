@@ -0,0 +1,13 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+class Patch_Bank;
+
+// factory bank of the G-Major, compiled into the program
+class Factory_Bank {
+public:
+    static void load(Patch_Bank &pbank);
+};
@@ -0,0 +1,194 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "midi_file.h"
+#include <math.h>
+#include <string.h>
+
+static inline uint32_t load_u32be(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline void store_u32be(uint8_t *p, uint32_t x)
+{
+    p[0] = x >> 24;
+    p[1] = x >> 16;
+    p[2] = x >> 8;
+    p[3] = x;
+}
+
+// variable-length quantity of at most 4 bytes
+static bool read_vlq(const uint8_t *&p, const uint8_t *end, uint32_t &value)
+{
+    value = 0;
+    for (unsigned i = 0; i < 4 && p < end; ++i) {
+        uint8_t byte = *p++;
+        value = (value << 7) | (byte & 0x7f);
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+static void write_vlq(std::vector<uint8_t> &data, uint32_t value)
+{
+    uint8_t buf[5];
+    unsigned n = 0;
+    do {
+        buf[n++] = value & 0x7f;
+        value >>= 7;
+    } while (value);
+    while (n-- > 0)
+        data.push_back(buf[n] | (n ? 0x80 : 0));
+}
+
+// returns false if the callback has stopped the reading
+static bool read_track(const uint8_t *p, const uint8_t *end, const Midi_File::Sysex_Callback &cb)
+{
+    uint8_t running_status = 0;
+    // sysex which is split in a F0 packet and F7 continuations
+    std::vector<uint8_t> split;
+    bool in_split = false;
+
+    while (p < end) {
+        uint32_t delta;
+        if (!read_vlq(p, end, delta) || p == end)
+            return true;
+
+        uint8_t status = *p;
+        if (status & 0x80)
+            ++p;
+        else if (running_status)
+            status = running_status;
+        else
+            return true;
+
+        if (status < 0xf0) {
+            running_status = status;
+            unsigned size = ((status & 0xe0) == 0xc0) ? 1 : 2;
+            if ((size_t)(end - p) < size)
+                return true;
+            p += size;
+            continue;
+        }
+
+        // system events cancel the running status
+        running_status = 0;
+
+        if (status == 0xff) {
+            if (p == end)
+                return true;
+            ++p;  // meta type
+        }
+        else if (status != 0xf0 && status != 0xf7)
+            return true;
+
+        uint32_t size;
+        if (!read_vlq(p, end, size) || (size_t)(end - p) < size)
+            return true;
+        const uint8_t *body = p;
+        p += size;
+
+        bool complete = size > 0 && body[size - 1] == 0xf7;
+
+        if (status == 0xf0) {
+            in_split = !complete;
+            if (complete) {
+                if (!cb(body, size))
+                    return false;
+            }
+            else
+                split.assign(body, body + size);
+        }
+        else if (status == 0xf7 && in_split) {
+            split.insert(split.end(), body, body + size);
+            if (complete) {
+                in_split = false;
+                if (!cb(split.data(), split.size()))
+                    return false;
+            }
+        }
+        else if (status == 0xf7 && complete && size > 1 && body[0] == 0xf0) {
+            // an escaped sysex, stored with its status byte
+            if (!cb(body + 1, size - 1))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool Midi_File::read_sysex(const uint8_t *data, size_t length, const Sysex_Callback &cb)
+{
+    const uint8_t *p = data;
+    const uint8_t *end = data + length;
+
+    if (length < 14 || memcmp(p, "MThd", 4) != 0)
+        return false;
+    uint32_t header_size = load_u32be(p + 4);
+    if (header_size < 6 || header_size > length - 8)
+        return false;
+    p += 8 + header_size;
+
+    // a truncated file gives the events which are complete
+    while ((size_t)(end - p) >= 8) {
+        uint32_t size = load_u32be(p + 4);
+        const uint8_t *chunk = p + 8;
+        const uint8_t *chunk_end = (size < (size_t)(end - chunk)) ? (chunk + size) : end;
+        if (memcmp(p, "MTrk", 4) == 0 && !read_track(chunk, chunk_end, cb))
+            break;
+        p = chunk_end;
+    }
+
+    return true;
+}
+
+void Midi_File::write_sysex(const uint8_t *messages, size_t length, double interval, std::vector<uint8_t> &data)
+{
+    static const uint8_t header[] = {
+        'M', 'T', 'h', 'd', 0, 0, 0, 6,
+        0, 0,  // format 0
+        0, 1,  // 1 track
+        ticks_per_quarter >> 8, ticks_per_quarter & 0xff,
+        'M', 'T', 'r', 'k', 0, 0, 0, 0,
+        0, 0xff, 0x51, 3, (tempo >> 16) & 0xff, (tempo >> 8) & 0xff, tempo & 0xff,
+    };
+
+    data.assign(header, header + sizeof(header));
+    data.reserve(data.size() + length + length / 64 + 16);
+
+    const double ticks_per_second = 1e6 * ticks_per_quarter / tempo;
+    // 10 bits for each byte at 31250 baud
+    const double byte_duration = 10.0 / 31250;
+
+    const uint8_t *p = messages;
+    const uint8_t *end = messages + length;
+    double delay = 0;
+
+    while (p < end) {
+        const uint8_t *start = (const uint8_t *)memchr(p, 0xf0, end - p);
+        if (!start)
+            break;
+        const uint8_t *stop = (const uint8_t *)memchr(start + 1, 0xf7, end - (start + 1));
+        if (!stop)
+            break;
+        p = stop + 1;
+
+        size_t size = p - start;
+        write_vlq(data, (uint32_t)ceil(delay * ticks_per_second));
+        data.push_back(0xf0);
+        write_vlq(data, size - 1);
+        data.insert(data.end(), start + 1, p);
+
+        delay = size * byte_duration + interval;
+    }
+
+    static const uint8_t end_of_track[] = {0, 0xff, 0x2f, 0};
+    data.insert(data.end(), end_of_track, end_of_track + sizeof(end_of_track));
+
+    const size_t track_offset = 22;
+    store_u32be(&data[track_offset - 4], data.size() - track_offset);
+}
@@ -0,0 +1,31 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <functional>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+// system exclusive events of standard MIDI files
+class Midi_File {
+public:
+    // receives the bytes of a sysex message which follow the F0 status,
+    // up to and including the F7. returns false to stop reading.
+    typedef std::function<bool(const uint8_t *data, size_t length)> Sysex_Callback;
+
+    // walks the tracks and yields the sysex messages in the order of the
+    // file, pointing into the input unless a message is split in packets.
+    // returns false if the data is not a MIDI file.
+    static bool read_sysex(const uint8_t *data, size_t length, const Sysex_Callback &cb);
+
+    // writes a single track file of the sysex messages (F0 ... F7) which
+    // are concatenated in the input. each message is delayed after the
+    // previous one by its transmission time at MIDI rate, plus an interval.
+    static void write_sysex(const uint8_t *messages, size_t length, double interval, std::vector<uint8_t> &data);
+
+    enum { ticks_per_quarter = 96 };
+    enum { tempo = 500000 };  // microseconds per quarter note
+};
@@ -6,6 +6,7 @@
 #include "parameter.h"
 #include "patch.h"
 #include "app_i18n.h"
+#include <algorithm>
 #include <math.h>
 #include <string.h>
 #include <assert.h>
@@ -109,18 +110,12 @@ static std::string msec(int value)
 
 static std::string tenths_sec(int value)
 {
-    double v = value * 0.1;
-    char buf[32];
-    sprintf(buf, "%.1f", v);
-    return std::string(buf) + _P("Unit|", "s");
+    return format_fixed(value * 0.1, 1) + _P("Unit|", "s");
 }
 
 static std::string tenths_msec(int value)
 {
-    double v = value * 0.1;
-    char buf[32];
-    sprintf(buf, "%.1f", v);
-    return std::string(buf) + _P("Unit|", "ms");
+    return format_fixed(value * 0.1, 1) + _P("Unit|", "ms");
 }
 
 static std::string oct_choice(const char *choice)
@@ -128,51 +123,38 @@ static std::string oct_choice(const char *choice)
     return std::string(choice) + _P("Unit|", "oct");
 }
 
-static std::string msec_choice(const char *choice)
+static std::string msec_number(double v)
 {
-    size_t length = strlen(choice);
-
-    double v;
-    unsigned count;
-    if (sscanf_lc(choice, "%lf%n", "C", &v, &count) == 1 && count == length) {
-        char buf[32];
-        const char *unit;
-        if (fabs(v) < 100) {
-            sprintf(buf, "%.0f", v);
-            unit = _P("Unit|", "ms");
-        }
-        else {
-            sprintf(buf, "%.2f", v * 1e-3);
-            unit = _P("Unit|", "s");
-        }
-        return std::string(buf) + unit;
-    }
-
-    return choice;
+    if (fabs(v) < 100)
+        return format_fixed(v, 0) + _P("Unit|", "ms");
+    else
+        return format_fixed(v * 1e-3, 2) + _P("Unit|", "s");
 }
 
-static std::string hz_choice(const char *choice)
+static std::string hz_number(double v)
 {
-    size_t length = strlen(choice);
-
-    double v;
-    unsigned count;
-    if (sscanf_lc(choice, "%lf%n", "C", &v, &count) == 1 && count == length) {
-        char buf[32];
-        sprintf(buf, "%.2f", v);
-        return std::string(buf) + _P("Unit|", "Hz");
-    }
-    else if (sscanf_lc(choice, "%lfk%n", "C", &v, &count) == 1 && count == length) {
-        char buf[32];
-        sprintf(buf, "%.2f", v);
-        return std::string(buf) + _P("Unit|", "kHz");
-    }
-
-    return choice;
+    if (fabs(v) < 1000)
+        return format_fixed(v, 2) + _P("Unit|", "Hz");
+    else
+        return format_fixed(v * 1e-3, 2) + _P("Unit|", "kHz");
 }
 
 }  // namespace Formatting
 
+// the note lengths of the tempo choices, in whole notes
+static std::vector<double> tempo_numbers()
+{
+    std::vector<double> numbers{NAN};
+    for (double length = 1.0; length >= 1.0 / 32; length *= 0.5) {
+        if (length < 1.0)
+            numbers.push_back(length * 1.5);  // dotted
+        numbers.push_back(length);
+        if (length < 1.0)
+            numbers.push_back(length * (2.0 / 3.0));  // triplet
+    }
+    return numbers;
+}
+
 ///
 
 Parameter_Access *Parameter_Access::with_string_fn(std::function<std::string(int)> fn)
@@ -223,6 +205,42 @@ std::string Parameter_Access::to_string(int value) const
     return std::to_string(value);
 }
 
+// storage of the labels, which are kept as long as the program runs
+static const char *store_label(const std::string &text)
+{
+    static std::vector<std::unique_ptr<char[]>> chunks;
+    static size_t chunk_used = 0;
+    static size_t chunk_size = 0;
+
+    size_t size = text.size() + 1;
+    if (size > chunk_size - chunk_used) {
+        chunk_size = std::max<size_t>(16384, size);
+        chunks.emplace_back(new char[chunk_size]);
+        chunk_used = 0;
+    }
+
+    char *label = chunks.back().get() + chunk_used;
+    memcpy(label, text.c_str(), size);
+    chunk_used += size;
+    return label;
+}
+
+const char *Parameter_Access::label(int value) const
+{
+    int vmin = min(), vmax = max();
+    value = (value < vmin) ? vmin : value;
+    value = (value > vmax) ? vmax : value;
+
+    std::vector<const char *> &labels = label_cache;
+    if (labels.size() != (size_t)(vmax - vmin + 1))
+        labels.assign(vmax - vmin + 1, nullptr);
+
+    const char *&label = labels[value - vmin];
+    if (!label)
+        label = store_label(to_string(value));
+    return label;
+}
+
 bool Parameter_Collection::contains(const Parameter_Access &p) const
 {
     for (size_t i = 0, n = slots.size(); i < n; ++i) {
@@ -294,6 +312,46 @@ PA_Choice *PA_Choice::with_choice_string_fn(std::function<std::string(const char
     return this;
 }
 
+static double parse_choice_number(const char *text)
+{
+    const char *end = text + strlen(text);
+
+    double v;
+    const char *p = parse_decimal(text, end, v);
+    if (!p)
+        return NAN;
+    if (p + 1 == end && *p == 'k')
+        return v * 1e3;
+    if (p != end)
+        return NAN;
+    return v;
+}
+
+PA_Choice *PA_Choice::with_numbers(Choice_Unit unit)
+{
+    std::vector<double> numbers(values.size());
+    for (size_t i = 0, n = values.size(); i < n; ++i)
+        numbers[i] = parse_choice_number(values[i]);
+    return with_numbers(unit, std::move(numbers));
+}
+
+PA_Choice *PA_Choice::with_numbers(Choice_Unit unit, std::vector<double> numbers)
+{
+    assert(numbers.size() == values.size());
+    this->unit = unit;
+    this->numbers = std::move(numbers);
+    return this;
+}
+
+PA_Choice *PA_Choice::with_number_string_fn(std::function<std::string(double)> fn)
+{
+    to_string_fn = [this, fn](int v) -> std::string {
+                       double number = this->number(v);
+                       return isnan(number) ? std::string(values[clamp(v)]) : fn(number);
+                   };
+    return this;
+}
+
 int PA_Choice::get(const Patch &pat) const
 {
     int v = load_int(&pat.raw_data[index], size);
@@ -321,6 +379,17 @@ std::string PA_Choice::to_string(int value) const
     return values[clamp(value)];
 }
 
+bool PA_Choice::has_number(int value) const
+{
+    return !isnan(number(value));
+}
+
+double PA_Choice::number(int value) const
+{
+    value = clamp(value);
+    return ((unsigned)value < numbers.size()) ? numbers[value] : NAN;
+}
+
 PA_Bits *PA_Bits::with_min_max(int vmin, int vmax)
 {
     this->vmin = vmin;
@@ -336,10 +405,12 @@ PA_Bits *PA_Bits::with_offset(int offset)
 
 int PA_Bits::get(const Patch &pat) const
 {
-    std::vector<bool> bits = read_bits7(&pat.raw_data[index], size);
+    const uint8_t *src = &pat.raw_data[index];
     int v = 0;
-    for (unsigned i = 0; i < bit_size; ++i)
-        v |= (unsigned)bits[bit_offset + i] << i;
+    for (unsigned i = 0; i < bit_size; ++i) {
+        unsigned bit = bit_offset + i;
+        v |= (unsigned)((src[bit / 7] >> (bit % 7)) & 1) << i;
+    }
     return clamp(v - offset);
 }
 
@@ -373,12 +444,14 @@ P_Compressor::P_Compressor()
                                       {"1.0", "1.4", "2.0", "3.0", "5.0", "7.0", "10", "14", "20", "30", "50", "70"},
                                       _("Attack"), _("The Attack time is the response time of the Compressor. The shorter the attack time the sooner the Compressor will reach the specified Ratio after the signal rises above the Threshold.")))
                        ->with_offset(3)
-                       ->with_choice_string_fn(&Formatting::msec_choice));
+                       ->with_numbers(CU_Millisecond)
+                       ->with_number_string_fn(&Formatting::msec_number));
     slots.emplace_back((new PA_Choice(176, 4,
                                       {"50", "70", "100", "140", "200", "300", "500", "700", "1000", "1400", "2000"},
                                       _("Release"), _("The Release time is the time it takes for the Compressor to release the gain reduction of the signal after the Input signal drops below the Threshold point again.")))
                        ->with_offset(3)
-                       ->with_choice_string_fn(&Formatting::msec_choice));
+                       ->with_numbers(CU_Millisecond)
+                       ->with_number_string_fn(&Formatting::msec_number));
     slots.emplace_back((new PA_Integer(180, 4, _("Gain"), _("Use this Gain parameter to compensate for the level changes caused by the applied compression.")))
                        ->with_min_max(-6, 6)
                        ->with_string_fn(&Formatting::db));
@@ -390,12 +463,15 @@ P_Equalizer::P_Equalizer()
                                       {"40.97", "42.17", "43.40", "44.67", "45.97", "47.32", "48.70", "50.12", "51.58", "53.09", "54.64", "56.23", "57.88", "59.57", "61.31", "63.10", "64.94", "66.83", "68.79", "70.79", "72.86", "74.99", "77.18", "79.43", "81.75", "84.14", "86.60", "89.13", "91.73", "94.41", "97.16", "100.0", "102.9", "105.9", "109.0", "112.2", "115.5", "118.9", "122.3", "125.9", "129.6", "133.4", "137.2", "141.3", "145.4", "149.6", "154.0", "158.5", "163.1", "167.9", "172.8", "177.8", "183.0", "188.4", "193.9", "199.5", "205.4", "211.3", "217.5", "223.9", "230.4", "237.1", "244.1", "251.2", "258.5", "266.1", "273.8", "281.8", "290.1", "298.5", "307.3", "316.2", "325.5", "335.0", "344.7", "354.8", "365.2", "375.8", "386.8", "398.1", "409.7", "421.7", "434.0", "446.7", "459.7", "473.2", "487.0", "501.2", "515.8", "530.9", "546.4", "562.3", "578.8", "595.7", "613.1", "631.0", "649.4", "668.3", "687.9", "707.9", "728.6", "749.9", "771.8", "794.3", "817.5", "841.4", "866.0", "891.3", "917.3", "944.1", "971.6", "1.00k", "1.03k", "1.06k", "1.09k", "1.12k", "1.15k", "1.19k", "1.22k", "1.26k", "1.30k", "1.33k", "1.37k", "1.41k", "1.45k", "1.50k", "1.54k", "1.58k", "1.63k", "1.68k", "1.73k", "1.78k", "1.83k", "1.88k", "1.94k", "2.00k", "2.05k", "2.11k", "2.18k", "2.24k", "2.30k", "2.37k", "2.44k", "2.51k", "2.59k", "2.66k", "2.74k", "2.82k", "2.90k", "2.99k", "3.07k", "3.16k", "3.25k", "3.35k", "3.45k", "3.55k", "3.65k", "3.76k", "3.87k", "3.98k", "4.10k", "4.22k", "4.34k", "4.47k", "4.60k", "4.73k", "4.87k", "5.01k", "5.16k", "5.31k", "5.46k", "5.62k", "5.79k", "5.96k", "6.13k", "6.31k", "6.49k", "6.68k", "6.88k", "7.08k", "7.29k", "7.50k", "7.72k", "7.94k", "8.18k", "8.41k", "8.66k", "8.91k", "9.17k", "9.44k", "9.72k", "10.0k", "10.3k", "10.6k", "10.9k", "11.2k", "11.5k", "11.9k", "12.2k", "12.6k", "13.0k", "13.3k", "13.7k", "14.1k", "14.5k", "15.0k", "15.4k", "15.8k", "16.3k", "16.8k", "17.3k", "17.8k", "18.3k", "18.8k", "19.4k", "20.0k", "Off"},
                                       _("Frequency"), _("Sets the operating frequency for the selected band.")))
                        ->with_offset(25)
-                       ->with_choice_string_fn(&Formatting::hz_choice));
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number));
     slots.emplace_back((new PA_Choice(580, 4, frequency1().values, frequency1().name, frequency1().description))
                        ->with_offset(frequency1().offset)
+                       ->with_numbers(frequency1().unit, frequency1().numbers)
                        ->with_string_fn(frequency1().to_string_fn));
     slots.emplace_back((new PA_Choice(592, 4, frequency1().values, frequency1().name, frequency1().description))
                        ->with_offset(frequency1().offset)
+                       ->with_numbers(frequency1().unit, frequency1().numbers)
                        ->with_string_fn(frequency1().to_string_fn));
     slots.emplace_back((new PA_Integer(572, 4, _("Gain"), _("Gains or attenuates the selected frequency area.")))
                        ->with_min_max(-12, 12)
@@ -410,12 +486,15 @@ P_Equalizer::P_Equalizer()
                                       {"0.2", "0.25", "0.32", "0.4", "0.5", "0.63", "0.8", "1.0", "1.25", "1.6", "2.0", "2.5", "3.2", "4.0"},
                                       _("Width"), _("Width defines the area around the set frequency that the EQ will amplify or attenuate.")))
                        ->with_offset(3)
+                       ->with_numbers(CU_Octave)
                        ->with_choice_string_fn(&Formatting::oct_choice));
     slots.emplace_back((new PA_Choice(588, 4, width1().values, width1().name, width1().description))
                        ->with_offset(width1().offset)
+                       ->with_numbers(width1().unit, width1().numbers)
                        ->with_string_fn(width1().to_string_fn));
     slots.emplace_back((new PA_Choice(600, 4, width1().values, width1().name, width1().description))
                        ->with_offset(width1().offset)
+                       ->with_numbers(width1().unit, width1().numbers)
                        ->with_string_fn(width1().to_string_fn));
 }
 
@@ -640,7 +719,8 @@ P_Delay::Ping_Pong::Ping_Pong()
                        ->with_modifier_at(108));
     slots.emplace_back((new PA_Choice(432, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Integer(436, 4, _("Width"), _("The Width parameter determines whether the Left or Right repetitions are panned 100% or not.")))
                        ->with_min_max(0, 100)
                        ->with_string_fn(&Formatting::percent));
@@ -651,12 +731,14 @@ P_Delay::Ping_Pong::Ping_Pong()
     slots.emplace_back((new PA_Choice(448, 4,
                                       {"2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("FB Hi cut"), _("Attenuates the frequencies above the set frequency thereby giving you a more analog Delay sound that in many cases will blend better in the overall sound.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(116));
     slots.emplace_back((new PA_Choice(452, 4,
                                       {_("Off"), "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k"},
                                       _("FB Lo cut"), _("Attenuates the frequencies below the set frequency.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(120));
     slots.emplace_back((new PA_Integer(472, 4, _("Mix"), _("Sets the relation between the dry signal and the applied effect in this block.")))
                        ->with_min_max(0, 100)
@@ -678,7 +760,8 @@ P_Delay::Dynamic::Dynamic()
                        ->with_modifier_at(108));
     slots.emplace_back((new PA_Choice(432, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Integer(440, 4, _("Feedback"), _("Determines how many repetitions there will be.")))
                        ->with_min_max(0, 100)
                        ->with_string_fn(&Formatting::percent)
@@ -686,12 +769,14 @@ P_Delay::Dynamic::Dynamic()
     slots.emplace_back((new PA_Choice(448, 4,
                                       {"2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("FB Hi cut"), _("Attenuates the frequencies above the set frequency thereby giving you a more analog Delay sound that in many cases will blend better in the overall sound.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(116));
     slots.emplace_back((new PA_Choice(452, 4,
                                       {_("Off"), "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k"},
                                       _("FB Lo cut"), _("Attenuates the frequencies below the set frequency.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(120));
     slots.emplace_back((new PA_Integer(456, 4, _("Offset R"), _("Offsets the Delay repeats in the Right channel only. For a true wide stereo Delay the Delay in the two channels should not appear at the exact same time.")))
                        ->with_min_max(-200, 200)
@@ -706,7 +791,8 @@ P_Delay::Dynamic::Dynamic()
                                       {"20", "30", "50", "70", "100", "140", "200", "300", "500", "700", "1000"},
                                       _("Release"), _("A parameter relative to a Compressor release.")))
                        ->with_offset(3)
-                       ->with_choice_string_fn(&Formatting::msec_choice));
+                       ->with_numbers(CU_Millisecond)
+                       ->with_number_string_fn(&Formatting::msec_number));
     slots.emplace_back((new PA_Integer(472, 4, _("Mix"), _("Sets the relation between the dry signal and the applied effect in this block.")))
                        ->with_min_max(0, 100)
                        ->with_string_fn(&Formatting::percent)
@@ -731,10 +817,12 @@ P_Delay::Dual::Dual()
                        ->with_modifier_at(112));
     slots.emplace_back((new PA_Choice(432, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo 1"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo 1"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Choice(436, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo 2"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo 2"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Integer(440, 4, _("Feedback 1"), _("Determines the number of repetitions of the Delay of the first Delay Line.")))
                        ->with_min_max(0, 100)
                        ->with_string_fn(&Formatting::percent)
@@ -746,12 +834,14 @@ P_Delay::Dual::Dual()
     slots.emplace_back((new PA_Choice(448, 4,
                                       {"2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("FB Hi cut"), _("Attenuates the frequencies above the set frequency thereby giving you a more analog Delay sound that in many cases will blend better in the overall sound.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(124));
     slots.emplace_back((new PA_Choice(452, 4,
                                       {_("Off"), "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k"},
                                       _("FB Lo cut"), _("Attenuates the frequencies below the set frequency.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(128));
     slots.emplace_back((new PA_Integer(456, 4, _("Pan 1"), _("Pans the Delay repetitions of the first Delay Line.")))
                        ->with_min_max(-50, 50)
@@ -809,7 +899,8 @@ P_Filter::Auto_Resonance::Auto_Resonance()
     slots.emplace_back((new PA_Choice(252, 4,
                                       {"1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k"},
                                       _("Freq Max"/*Frequency Max*/), _("Limits the frequency range in which the sweep will be performed.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice));
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number));
     slots.emplace_back((new PA_Integer(280, 4, _("Mix"), _("Sets the relation between the dry signal and the applied effect in this block.")))
                        ->with_min_max(0, 100)
                        ->with_string_fn(&Formatting::percent)
@@ -830,7 +921,8 @@ P_Filter::Resonance::Resonance()
     slots.emplace_back((new PA_Choice(272, 4,
                                       {"158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k"},
                                       _("Hi Cut"), _("Determines the frequency above which the Hi Cut filter will attenuate the high-end frequencies of the generated effect.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(28));
     slots.emplace_back((new PA_Integer(276, 4, _("Hi Reso"/*Hi Resonance*/), _("Sets the amount of Resonance in the Hi Cut filter.")))
                        ->with_min_max(0, 100)
@@ -853,7 +945,8 @@ P_Filter::Vintage_Phaser::Vintage_Phaser()
     slots.emplace_back((new PA_Choice(244, 4,
                                       {".050", ".052", ".053", ".055", ".056", ".058", ".060", ".061", ".063", ".065", ".067", ".069", ".071", ".073", ".075", ".077", ".079", ".082", ".084", ".087", ".089", ".092", ".094", ".097", ".100", ".103", ".106", ".109", ".112", ".115", ".119", ".122", ".126", ".130", ".133", ".137", ".141", ".145", ".150", ".154", ".158", ".163", ".168", ".173", ".178", ".183", ".188", ".194", ".200", ".205", ".211", ".218", ".224", ".230", ".237", ".244", ".251", ".259", ".266", ".274", ".282", ".290", ".299", ".307", ".316", ".325", ".335", ".345", ".355", ".365", ".376", ".387", ".398", ".410", ".422", ".434", ".447", ".460", ".473", ".487", ".501", ".516", ".531", ".546", ".562", ".579", ".596", ".613", ".631", ".649", ".668", ".688", ".708", ".729", ".750", ".772", ".794", ".818", ".841", ".866", ".891", ".917", ".944", ".972", "1.00", "1.03", "1.06", "1.09", "1.12", "1.15", "1.19", "1.22", "1.26", "1.30", "1.33", "1.37", "1.41", "1.45", "1.50", "1.54", "1.58", "1.63", "1.68", "1.73", "1.78", "1.83", "1.88", "1.94", "2.00", "2.05", "2.11", "2.18", "2.24", "2.30", "2.37", "2.44", "2.51", "2.59", "2.66", "2.74", "2.82", "2.90", "2.99", "3.07", "3.16", "3.25", "3.35", "3.45", "3.55", "3.65", "3.76", "3.87", "3.98", "4.10", "4.22", "4.34", "4.47", "4.60", "4.73", "4.87", "5.01", "5.16", "5.31", "5.46", "5.62", "5.79", "5.96", "6.13", "6.31", "6.49", "6.68", "6.88", "7.08", "7.29", "7.50", "7.72", "7.94", "8.18", "8.41", "8.66", "8.91", "9.17", "9.44", "9.72", "10.00", "10.29", "10.59", "10.90", "11.22", "11.55", "11.89", "12.23", "12.59", "12.96", "13.34", "13.72", "14.13", "14.54", "14.96", "15.40", "15.85", "16.31", "16.79", "17.28", "17.78", "18.30", "18.84", "19.39", "19.95"},
                                       _("Speed"), _("Controls the Speed of the Phaser.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(28));
     slots.emplace_back((new PA_Integer(248, 4, _("Depth"), _("Controls the Depth of the Phaser.")))
                        ->with_min_max(0, 100)
@@ -861,7 +954,8 @@ P_Filter::Vintage_Phaser::Vintage_Phaser()
                        ->with_modifier_at(32));
     slots.emplace_back((new PA_Choice(252, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Integer(260, 4, _("Feedback"), _("Controls the amount of feedback in the Phaser. Setting this parameter to \"-100\" reverses the phase of the signal that is fed back to the algorithm Input.")))
                        ->with_min_max(-100, 100)
                        ->with_modifier_at(36));
@@ -887,7 +981,8 @@ P_Filter::Smooth_Phaser::Smooth_Phaser()
     slots.emplace_back((new PA_Choice(244, 4,
                                       {".050", ".052", ".053", ".055", ".056", ".058", ".060", ".061", ".063", ".065", ".067", ".069", ".071", ".073", ".075", ".077", ".079", ".082", ".084", ".087", ".089", ".092", ".094", ".097", ".100", ".103", ".106", ".109", ".112", ".115", ".119", ".122", ".126", ".130", ".133", ".137", ".141", ".145", ".150", ".154", ".158", ".163", ".168", ".173", ".178", ".183", ".188", ".194", ".200", ".205", ".211", ".218", ".224", ".230", ".237", ".244", ".251", ".259", ".266", ".274", ".282", ".290", ".299", ".307", ".316", ".325", ".335", ".345", ".355", ".365", ".376", ".387", ".398", ".410", ".422", ".434", ".447", ".460", ".473", ".487", ".501", ".516", ".531", ".546", ".562", ".579", ".596", ".613", ".631", ".649", ".668", ".688", ".708", ".729", ".750", ".772", ".794", ".818", ".841", ".866", ".891", ".917", ".944", ".972", "1.00", "1.03", "1.06", "1.09", "1.12", "1.15", "1.19", "1.22", "1.26", "1.30", "1.33", "1.37", "1.41", "1.45", "1.50", "1.54", "1.58", "1.63", "1.68", "1.73", "1.78", "1.83", "1.88", "1.94", "2.00", "2.05", "2.11", "2.18", "2.24", "2.30", "2.37", "2.44", "2.51", "2.59", "2.66", "2.74", "2.82", "2.90", "2.99", "3.07", "3.16", "3.25", "3.35", "3.45", "3.55", "3.65", "3.76", "3.87", "3.98", "4.10", "4.22", "4.34", "4.47", "4.60", "4.73", "4.87", "5.01", "5.16", "5.31", "5.46", "5.62", "5.79", "5.96", "6.13", "6.31", "6.49", "6.68", "6.88", "7.08", "7.29", "7.50", "7.72", "7.94", "8.18", "8.41", "8.66", "8.91", "9.17", "9.44", "9.72", "10.00", "10.29", "10.59", "10.90", "11.22", "11.55", "11.89", "12.23", "12.59", "12.96", "13.34", "13.72", "14.13", "14.54", "14.96", "15.40", "15.85", "16.31", "16.79", "17.28", "17.78", "18.30", "18.84", "19.39", "19.95"},
                                       _("Speed"), _("Controls the Speed of the Phaser.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(28));
     slots.emplace_back((new PA_Integer(248, 4, _("Depth"), _("Controls the Depth of the Phaser.")))
                        ->with_min_max(0, 100)
@@ -895,7 +990,8 @@ P_Filter::Smooth_Phaser::Smooth_Phaser()
                        ->with_modifier_at(32));
     slots.emplace_back((new PA_Choice(252, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Integer(260, 4, _("Feedback"), _("Controls the amount of feedback in the Phaser. Setting this parameter to \"-100\" reverses the phase of the signal that is fed back to the algorithm Input.")))
                        ->with_min_max(-100, 100)
                        ->with_modifier_at(36));
@@ -921,7 +1017,8 @@ P_Filter::Tremolo::Tremolo()
     slots.emplace_back((new PA_Choice(244, 4,
                                       {".050", ".052", ".053", ".055", ".056", ".058", ".060", ".061", ".063", ".065", ".067", ".069", ".071", ".073", ".075", ".077", ".079", ".082", ".084", ".087", ".089", ".092", ".094", ".097", ".100", ".103", ".106", ".109", ".112", ".115", ".119", ".122", ".126", ".130", ".133", ".137", ".141", ".145", ".150", ".154", ".158", ".163", ".168", ".173", ".178", ".183", ".188", ".194", ".200", ".205", ".211", ".218", ".224", ".230", ".237", ".244", ".251", ".259", ".266", ".274", ".282", ".290", ".299", ".307", ".316", ".325", ".335", ".345", ".355", ".365", ".376", ".387", ".398", ".410", ".422", ".434", ".447", ".460", ".473", ".487", ".501", ".516", ".531", ".546", ".562", ".579", ".596", ".613", ".631", ".649", ".668", ".688", ".708", ".729", ".750", ".772", ".794", ".818", ".841", ".866", ".891", ".917", ".944", ".972", "1.00", "1.03", "1.06", "1.09", "1.12", "1.15", "1.19", "1.22", "1.26", "1.30", "1.33", "1.37", "1.41", "1.45", "1.50", "1.54", "1.58", "1.63", "1.68", "1.73", "1.78", "1.83", "1.88", "1.94", "2.00", "2.05", "2.11", "2.18", "2.24", "2.30", "2.37", "2.44", "2.51", "2.59", "2.66", "2.74", "2.82", "2.90", "2.99", "3.07", "3.16", "3.25", "3.35", "3.45", "3.55", "3.65", "3.76", "3.87", "3.98", "4.10", "4.22", "4.34", "4.47", "4.60", "4.73", "4.87", "5.01", "5.16", "5.31", "5.46", "5.62", "5.79", "5.96", "6.13", "6.31", "6.49", "6.68", "6.88", "7.08", "7.29", "7.50", "7.72", "7.94", "8.18", "8.41", "8.66", "8.91", "9.17", "9.44", "9.72", "10.00", "10.29", "10.59", "10.90", "11.22", "11.55", "11.89", "12.23", "12.59", "12.96", "13.34", "13.72", "14.13", "14.54", "14.96", "15.40", "15.85", "16.31", "16.79", "17.28", "17.78", "18.30", "18.84", "19.39", "19.95"},
                                       _("Speed"), _("Sets the Speed of the Tremolo.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(28));
     slots.emplace_back((new PA_Integer(248, 4, _("Depth"), _("Controls the Depth of the Phaser.")))
                        ->with_min_max(0, 100)
@@ -929,14 +1026,16 @@ P_Filter::Tremolo::Tremolo()
                        ->with_modifier_at(32));
     slots.emplace_back((new PA_Choice(252, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Integer(260, 4, _("LFO P Width"/*LFO Pulse Width*/), _("Controls the division of the upper and the lower part of the current waveform, e.g. if Pulse Width is set to 75%, the upper half of the waveform will be on for 75% of the time.")))
                        ->with_min_max(0, 100)
                        ->with_string_fn(&Formatting::percent));
     slots.emplace_back((new PA_Choice(272, 4,
                                       {"19.95", "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("Hi Cut"), _("Attenuates the high frequencies of the Tremolo effect. Use the Hi Cut filter to create a less dominant Tremolo effect while keeping the Depth.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(36));
     slots.emplace_back((new PA_Choice(256, 4,
                                       {_P("Filter|Tremolo|Type|", "Soft"), _P("Filter|Tremolo|Type|", "Hard")},
@@ -953,7 +1052,8 @@ P_Filter::Panner::Panner()
     slots.emplace_back((new PA_Choice(244, 4,
                                       {".050", ".052", ".053", ".055", ".056", ".058", ".060", ".061", ".063", ".065", ".067", ".069", ".071", ".073", ".075", ".077", ".079", ".082", ".084", ".087", ".089", ".092", ".094", ".097", ".100", ".103", ".106", ".109", ".112", ".115", ".119", ".122", ".126", ".130", ".133", ".137", ".141", ".145", ".150", ".154", ".158", ".163", ".168", ".173", ".178", ".183", ".188", ".194", ".200", ".205", ".211", ".218", ".224", ".230", ".237", ".244", ".251", ".259", ".266", ".274", ".282", ".290", ".299", ".307", ".316", ".325", ".335", ".345", ".355", ".365", ".376", ".387", ".398", ".410", ".422", ".434", ".447", ".460", ".473", ".487", ".501", ".516", ".531", ".546", ".562", ".579", ".596", ".613", ".631", ".649", ".668", ".688", ".708", ".729", ".750", ".772", ".794", ".818", ".841", ".866", ".891", ".917", ".944", ".972", "1.00", "1.03", "1.06", "1.09", "1.12", "1.15", "1.19", "1.22", "1.26", "1.30", "1.33", "1.37", "1.41", "1.45", "1.50", "1.54", "1.58", "1.63", "1.68", "1.73", "1.78", "1.83", "1.88", "1.94", "2.00", "2.05", "2.11", "2.18", "2.24", "2.30", "2.37", "2.44", "2.51", "2.59", "2.66", "2.74", "2.82", "2.90", "2.99", "3.07", "3.16", "3.25", "3.35", "3.45", "3.55", "3.65", "3.76", "3.87", "3.98", "4.10", "4.22", "4.34", "4.47", "4.60", "4.73", "4.87", "5.01", "5.16", "5.31", "5.46", "5.62", "5.79", "5.96", "6.13", "6.31", "6.49", "6.68", "6.88", "7.08", "7.29", "7.50", "7.72", "7.94", "8.18", "8.41", "8.66", "8.91", "9.17", "9.44", "9.72", "10.00", "10.29", "10.59", "10.90", "11.22", "11.55", "11.89", "12.23", "12.59", "12.96", "13.34", "13.72", "14.13", "14.54", "14.96", "15.40", "15.85", "16.31", "16.79", "17.28", "17.78", "18.30", "18.84", "19.39", "19.95"},
                                       _("Speed"), _("Sets the Speed of the Panning.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(28));
     slots.emplace_back((new PA_Integer(248, 4, _("Width"), _("A 100% setting will sweep the signal completely from the Left to the Right. Very often a more subtle setting will be more applicable and blend better with the overall sound.")))
                        ->with_min_max(0, 100)
@@ -961,7 +1061,8 @@ P_Filter::Panner::Panner()
                        ->with_modifier_at(32));
     slots.emplace_back((new PA_Choice(252, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Integer(284, 4, _("Out level"), _("Sets the overall Output level of this block.")))
                        ->with_min_max(-100, 0)
                        ->with_string_fn(&Formatting::db)
@@ -997,7 +1098,8 @@ P_Modulation::Classic_Chorus::Classic_Chorus()
     slots.emplace_back((new PA_Choice(360, 4,
                                       {".050", ".052", ".053", ".055", ".056", ".058", ".060", ".061", ".063", ".065", ".067", ".069", ".071", ".073", ".075", ".077", ".079", ".082", ".084", ".087", ".089", ".092", ".094", ".097", ".100", ".103", ".106", ".109", ".112", ".115", ".119", ".122", ".126", ".130", ".133", ".137", ".141", ".145", ".150", ".154", ".158", ".163", ".168", ".173", ".178", ".183", ".188", ".194", ".200", ".205", ".211", ".218", ".224", ".230", ".237", ".244", ".251", ".259", ".266", ".274", ".282", ".290", ".299", ".307", ".316", ".325", ".335", ".345", ".355", ".365", ".376", ".387", ".398", ".410", ".422", ".434", ".447", ".460", ".473", ".487", ".501", ".516", ".531", ".546", ".562", ".579", ".596", ".613", ".631", ".649", ".668", ".688", ".708", ".729", ".750", ".772", ".794", ".818", ".841", ".866", ".891", ".917", ".944", ".972", "1.00", "1.03", "1.06", "1.09", "1.12", "1.15", "1.19", "1.22", "1.26", "1.30", "1.33", "1.37", "1.41", "1.45", "1.50", "1.54", "1.58", "1.63", "1.68", "1.73", "1.78", "1.83", "1.88", "1.94", "2.00", "2.05", "2.11", "2.18", "2.24", "2.30", "2.37", "2.44", "2.51", "2.59", "2.66", "2.74", "2.82", "2.90", "2.99", "3.07", "3.16", "3.25", "3.35", "3.45", "3.55", "3.65", "3.76", "3.87", "3.98", "4.10", "4.22", "4.34", "4.47", "4.60", "4.73", "4.87", "5.01", "5.16", "5.31", "5.46", "5.62", "5.79", "5.96", "6.13", "6.31", "6.49", "6.68", "6.88", "7.08", "7.29", "7.50", "7.72", "7.94", "8.18", "8.41", "8.66", "8.91", "9.17", "9.44", "9.72", "10.00", "10.29", "10.59", "10.90", "11.22", "11.55", "11.89", "12.23", "12.59", "12.96", "13.34", "13.72", "14.13", "14.54", "14.96", "15.40", "15.85", "16.31", "16.79", "17.28", "17.78", "18.30", "18.84", "19.39", "19.95"},
                                       _("Speed"), _("The Speed of the Chorus, also known as Rate.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(80));
     slots.emplace_back((new PA_Integer(364, 4, _("Depth"), _("The Depth parameter specifies the intensity of the Chorus effect - the value represents the amount of modulation.")))
                        ->with_min_max(0, 100)
@@ -1005,11 +1107,13 @@ P_Modulation::Classic_Chorus::Classic_Chorus()
                        ->with_modifier_at(84));
     slots.emplace_back((new PA_Choice(368, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Choice(372, 4,
                                       {"19.95", "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("Hi Cut"), _("Reduces the high-end frequencies in the Chorus effect. Try using the Hi Cut parameter as an option if you feel the Chorus effect is too dominant in your sound and turning down the Mix or Out level doesn't give you the dampening of the Chorus effect you are looking for.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(88));
     slots.emplace_back((new PA_Integer(396, 4, _("Mix"), _("Sets the relation between the dry signal and the applied effect in this block.")))
                        ->with_min_max(0, 100)
@@ -1028,7 +1132,8 @@ P_Modulation::Advanced_Chorus::Advanced_Chorus()
     slots.emplace_back((new PA_Choice(360, 4,
                                       {".050", ".052", ".053", ".055", ".056", ".058", ".060", ".061", ".063", ".065", ".067", ".069", ".071", ".073", ".075", ".077", ".079", ".082", ".084", ".087", ".089", ".092", ".094", ".097", ".100", ".103", ".106", ".109", ".112", ".115", ".119", ".122", ".126", ".130", ".133", ".137", ".141", ".145", ".150", ".154", ".158", ".163", ".168", ".173", ".178", ".183", ".188", ".194", ".200", ".205", ".211", ".218", ".224", ".230", ".237", ".244", ".251", ".259", ".266", ".274", ".282", ".290", ".299", ".307", ".316", ".325", ".335", ".345", ".355", ".365", ".376", ".387", ".398", ".410", ".422", ".434", ".447", ".460", ".473", ".487", ".501", ".516", ".531", ".546", ".562", ".579", ".596", ".613", ".631", ".649", ".668", ".688", ".708", ".729", ".750", ".772", ".794", ".818", ".841", ".866", ".891", ".917", ".944", ".972", "1.00", "1.03", "1.06", "1.09", "1.12", "1.15", "1.19", "1.22", "1.26", "1.30", "1.33", "1.37", "1.41", "1.45", "1.50", "1.54", "1.58", "1.63", "1.68", "1.73", "1.78", "1.83", "1.88", "1.94", "2.00", "2.05", "2.11", "2.18", "2.24", "2.30", "2.37", "2.44", "2.51", "2.59", "2.66", "2.74", "2.82", "2.90", "2.99", "3.07", "3.16", "3.25", "3.35", "3.45", "3.55", "3.65", "3.76", "3.87", "3.98", "4.10", "4.22", "4.34", "4.47", "4.60", "4.73", "4.87", "5.01", "5.16", "5.31", "5.46", "5.62", "5.79", "5.96", "6.13", "6.31", "6.49", "6.68", "6.88", "7.08", "7.29", "7.50", "7.72", "7.94", "8.18", "8.41", "8.66", "8.91", "9.17", "9.44", "9.72", "10.00", "10.29", "10.59", "10.90", "11.22", "11.55", "11.89", "12.23", "12.59", "12.96", "13.34", "13.72", "14.13", "14.54", "14.96", "15.40", "15.85", "16.31", "16.79", "17.28", "17.78", "18.30", "18.84", "19.39", "19.95"},
                                       _("Speed"), _("The Speed of the Chorus, also known as Rate.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(80));
     slots.emplace_back((new PA_Integer(364, 4, _("Depth"), _("The Depth parameter specifies the intensity of the Chorus effect - the value represents the amount of modulation.")))
                        ->with_min_max(0, 100)
@@ -1036,7 +1141,8 @@ P_Modulation::Advanced_Chorus::Advanced_Chorus()
                        ->with_modifier_at(84));
     slots.emplace_back((new PA_Choice(368, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Choice(372, 4,
                                       {"19.95", "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("Hi Cut"), _("Reduces the high-end frequencies in the Chorus effect. Try using the Hi Cut parameter as an option if you feel the Chorus effect is too dominant in your sound and turning down the Mix or Out level doesn't give you the dampening of the Chorus effect you are looking for.")))
@@ -1067,7 +1173,8 @@ P_Modulation::Classic_Flanger::Classic_Flanger()
     slots.emplace_back((new PA_Choice(360, 4,
                                       {".050", ".052", ".053", ".055", ".056", ".058", ".060", ".061", ".063", ".065", ".067", ".069", ".071", ".073", ".075", ".077", ".079", ".082", ".084", ".087", ".089", ".092", ".094", ".097", ".100", ".103", ".106", ".109", ".112", ".115", ".119", ".122", ".126", ".130", ".133", ".137", ".141", ".145", ".150", ".154", ".158", ".163", ".168", ".173", ".178", ".183", ".188", ".194", ".200", ".205", ".211", ".218", ".224", ".230", ".237", ".244", ".251", ".259", ".266", ".274", ".282", ".290", ".299", ".307", ".316", ".325", ".335", ".345", ".355", ".365", ".376", ".387", ".398", ".410", ".422", ".434", ".447", ".460", ".473", ".487", ".501", ".516", ".531", ".546", ".562", ".579", ".596", ".613", ".631", ".649", ".668", ".688", ".708", ".729", ".750", ".772", ".794", ".818", ".841", ".866", ".891", ".917", ".944", ".972", "1.00", "1.03", "1.06", "1.09", "1.12", "1.15", "1.19", "1.22", "1.26", "1.30", "1.33", "1.37", "1.41", "1.45", "1.50", "1.54", "1.58", "1.63", "1.68", "1.73", "1.78", "1.83", "1.88", "1.94", "2.00", "2.05", "2.11", "2.18", "2.24", "2.30", "2.37", "2.44", "2.51", "2.59", "2.66", "2.74", "2.82", "2.90", "2.99", "3.07", "3.16", "3.25", "3.35", "3.45", "3.55", "3.65", "3.76", "3.87", "3.98", "4.10", "4.22", "4.34", "4.47", "4.60", "4.73", "4.87", "5.01", "5.16", "5.31", "5.46", "5.62", "5.79", "5.96", "6.13", "6.31", "6.49", "6.68", "6.88", "7.08", "7.29", "7.50", "7.72", "7.94", "8.18", "8.41", "8.66", "8.91", "9.17", "9.44", "9.72", "10.00", "10.29", "10.59", "10.90", "11.22", "11.55", "11.89", "12.23", "12.59", "12.96", "13.34", "13.72", "14.13", "14.54", "14.96", "15.40", "15.85", "16.31", "16.79", "17.28", "17.78", "18.30", "18.84", "19.39", "19.95"},
                                       _("Speed"), _("The Speed of the Flanger, also known as Rate.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(80));
     slots.emplace_back((new PA_Integer(364, 4, _("Depth"), _("Adjusts the Depth of the Flanger, also known as Intensity. The value represents the amount of modulation applied.")))
                        ->with_min_max(0, 100)
@@ -1075,11 +1182,13 @@ P_Modulation::Classic_Flanger::Classic_Flanger()
                        ->with_modifier_at(84));
     slots.emplace_back((new PA_Choice(368, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Choice(372, 4,
                                       {"19.95", "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("Hi Cut"), _("Reduces the high-end frequencies in the Flanger effect. Try using the Hi Cut parameter as an option if you feel the Flanger effect is too dominant in your sound and turning down the Mix or Out level doesn't give you the dampening of the Flanger effect you are looking for.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(88));
     slots.emplace_back((new PA_Integer(376, 4, _("Feedback"), _("Controls the amount of Feedback/Resonance of the short modulated Delay that causes the Flange effect.")))
                        ->with_min_max(-100, 100)
@@ -1087,7 +1196,8 @@ P_Modulation::Classic_Flanger::Classic_Flanger()
     slots.emplace_back((new PA_Choice(380, 4,
                                       {"19.95", "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("FB Hi Cut"), _("A parameter than can attenuate the high-end frequencies of the resonance created via the Feedback parameter.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(96));
     slots.emplace_back((new PA_Integer(396, 4, _("Mix"), _("Sets the relation between the dry signal and the applied effect in this block.")))
                        ->with_min_max(0, 100)
@@ -1106,7 +1216,8 @@ P_Modulation::Advanced_Flanger::Advanced_Flanger()
     slots.emplace_back((new PA_Choice(360, 4,
                                       {".050", ".052", ".053", ".055", ".056", ".058", ".060", ".061", ".063", ".065", ".067", ".069", ".071", ".073", ".075", ".077", ".079", ".082", ".084", ".087", ".089", ".092", ".094", ".097", ".100", ".103", ".106", ".109", ".112", ".115", ".119", ".122", ".126", ".130", ".133", ".137", ".141", ".145", ".150", ".154", ".158", ".163", ".168", ".173", ".178", ".183", ".188", ".194", ".200", ".205", ".211", ".218", ".224", ".230", ".237", ".244", ".251", ".259", ".266", ".274", ".282", ".290", ".299", ".307", ".316", ".325", ".335", ".345", ".355", ".365", ".376", ".387", ".398", ".410", ".422", ".434", ".447", ".460", ".473", ".487", ".501", ".516", ".531", ".546", ".562", ".579", ".596", ".613", ".631", ".649", ".668", ".688", ".708", ".729", ".750", ".772", ".794", ".818", ".841", ".866", ".891", ".917", ".944", ".972", "1.00", "1.03", "1.06", "1.09", "1.12", "1.15", "1.19", "1.22", "1.26", "1.30", "1.33", "1.37", "1.41", "1.45", "1.50", "1.54", "1.58", "1.63", "1.68", "1.73", "1.78", "1.83", "1.88", "1.94", "2.00", "2.05", "2.11", "2.18", "2.24", "2.30", "2.37", "2.44", "2.51", "2.59", "2.66", "2.74", "2.82", "2.90", "2.99", "3.07", "3.16", "3.25", "3.35", "3.45", "3.55", "3.65", "3.76", "3.87", "3.98", "4.10", "4.22", "4.34", "4.47", "4.60", "4.73", "4.87", "5.01", "5.16", "5.31", "5.46", "5.62", "5.79", "5.96", "6.13", "6.31", "6.49", "6.68", "6.88", "7.08", "7.29", "7.50", "7.72", "7.94", "8.18", "8.41", "8.66", "8.91", "9.17", "9.44", "9.72", "10.00", "10.29", "10.59", "10.90", "11.22", "11.55", "11.89", "12.23", "12.59", "12.96", "13.34", "13.72", "14.13", "14.54", "14.96", "15.40", "15.85", "16.31", "16.79", "17.28", "17.78", "18.30", "18.84", "19.39", "19.95"},
                                       _("Speed"), _("The Speed of the Flanger, also known as Rate.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(80));
     slots.emplace_back((new PA_Integer(364, 4, _("Depth"), _("Adjusts the Depth of the Flanger, also known as Intensity. The value represents the amount of modulation applied.")))
                        ->with_min_max(0, 100)
@@ -1114,11 +1225,13 @@ P_Modulation::Advanced_Flanger::Advanced_Flanger()
                        ->with_modifier_at(84));
     slots.emplace_back((new PA_Choice(368, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Choice(372, 4,
                                       {"19.95", "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("Hi Cut"), _("Reduces the high-end frequencies in the Flanger effect. Try using the Hi Cut parameter as an option if you feel the Flanger effect is too dominant in your sound and turning down the Mix or Out level doesn't give you the dampening of the Flanger effect you are looking for.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(88));
     slots.emplace_back((new PA_Integer(376, 4, _("Feedback"), _("Controls the amount of Feedback/Resonance of the short modulated Delay that causes the Flange effect.")))
                        ->with_min_max(-100, 100)
@@ -1126,7 +1239,8 @@ P_Modulation::Advanced_Flanger::Advanced_Flanger()
     slots.emplace_back((new PA_Choice(380, 4,
                                       {"19.95", "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("FB Hi Cut"), _("A parameter than can attenuate the high-end frequencies of the resonance created via the Feedback parameter.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(96));
     slots.emplace_back((new PA_Integer(384, 4, _("Delay"), _("Flanger is basically a Delay being modulated by an LFO. This parameter makes it possible to change the length of that Delay. A typical flanger uses Delays at approximately 5 ms.")))
                        ->with_min_max(1, 500)
@@ -1154,7 +1268,8 @@ P_Modulation::Vibrato::Vibrato()
     slots.emplace_back((new PA_Choice(360, 4,
                                       {".050", ".052", ".053", ".055", ".056", ".058", ".060", ".061", ".063", ".065", ".067", ".069", ".071", ".073", ".075", ".077", ".079", ".082", ".084", ".087", ".089", ".092", ".094", ".097", ".100", ".103", ".106", ".109", ".112", ".115", ".119", ".122", ".126", ".130", ".133", ".137", ".141", ".145", ".150", ".154", ".158", ".163", ".168", ".173", ".178", ".183", ".188", ".194", ".200", ".205", ".211", ".218", ".224", ".230", ".237", ".244", ".251", ".259", ".266", ".274", ".282", ".290", ".299", ".307", ".316", ".325", ".335", ".345", ".355", ".365", ".376", ".387", ".398", ".410", ".422", ".434", ".447", ".460", ".473", ".487", ".501", ".516", ".531", ".546", ".562", ".579", ".596", ".613", ".631", ".649", ".668", ".688", ".708", ".729", ".750", ".772", ".794", ".818", ".841", ".866", ".891", ".917", ".944", ".972", "1.00", "1.03", "1.06", "1.09", "1.12", "1.15", "1.19", "1.22", "1.26", "1.30", "1.33", "1.37", "1.41", "1.45", "1.50", "1.54", "1.58", "1.63", "1.68", "1.73", "1.78", "1.83", "1.88", "1.94", "2.00", "2.05", "2.11", "2.18", "2.24", "2.30", "2.37", "2.44", "2.51", "2.59", "2.66", "2.74", "2.82", "2.90", "2.99", "3.07", "3.16", "3.25", "3.35", "3.45", "3.55", "3.65", "3.76", "3.87", "3.98", "4.10", "4.22", "4.34", "4.47", "4.60", "4.73", "4.87", "5.01", "5.16", "5.31", "5.46", "5.62", "5.79", "5.96", "6.13", "6.31", "6.49", "6.68", "6.88", "7.08", "7.29", "7.50", "7.72", "7.94", "8.18", "8.41", "8.66", "8.91", "9.17", "9.44", "9.72", "10.00", "10.29", "10.59", "10.90", "11.22", "11.55", "11.89", "12.23", "12.59", "12.96", "13.34", "13.72", "14.13", "14.54", "14.96", "15.40", "15.85", "16.31", "16.79", "17.28", "17.78", "18.30", "18.84", "19.39", "19.95"},
                                       _("Speed"), _("The Speed of the Vibrato, also known as Rate.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(80));
     slots.emplace_back((new PA_Integer(364, 4, _("Depth"), _("The amount of Pitch modulation applied.")))
                        ->with_min_max(0, 100)
@@ -1162,11 +1277,13 @@ P_Modulation::Vibrato::Vibrato()
                        ->with_modifier_at(84));
     slots.emplace_back((new PA_Choice(368, 4,
                                       {_P("*|Tempo|", "Ignored"), _P("*|Tempo|", "1"), _P("*|Tempo|", "1/2D"), _P("*|Tempo|", "1/2"), _P("*|Tempo|", "1/2T"), _P("*|Tempo|", "1/4D"), _P("*|Tempo|", "1/4"), _P("*|Tempo|", "1/4T"), _P("*|Tempo|", "1/8D"), _P("*|Tempo|", "1/8"), _P("*|Tempo|", "1/8T"), _P("*|Tempo|", "1/16D"), _P("*|Tempo|", "1/16"), _P("*|Tempo|", "1/16T"), _P("*|Tempo|", "1/32D"), _P("*|Tempo|", "1/32"), _P("*|Tempo|", "1/32T")},
-                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo."))));
+                                      _("Tempo"), _("The Tempo parameter sets the relationship to the global Tempo.")))
+                       ->with_numbers(CU_Note, tempo_numbers()));
     slots.emplace_back((new PA_Choice(372, 4,
                                       {"19.95", "22.39", "25.12", "28.18", "31.62", "35.48", "39.81", "44.67", "50.12", "56.23", "63.10", "70.79", "79.43", "89.13", "100.0", "112.2", "125.9", "141.3", "158.5", "177.8", "199.5", "223.9", "251.2", "281.8", "316.2", "354.8", "398.1", "446.7", "501.2", "562.3", "631.0", "707.9", "794.3", "891.3", "1.00k", "1.12k", "1.26k", "1.41k", "1.58k", "1.78k", "2.00k", "2.24k", "2.51k", "2.82k", "3.16k", "3.55k", "3.98k", "4.47k", "5.01k", "5.62k", "6.31k", "7.08k", "7.94k", "8.91k", "10.0k", "11.2k", "12.6k", "14.1k", "15.8k", "17.8k", _("Off")},
                                       _("Hi Cut"), _("Determines the frequency above which the Hi Cut filter will attenuate the high-end frequencies of the generated effect. Hi Cut filters can be used to give a less dominant effect even at high mix levels.")))
-                       ->with_choice_string_fn(&Formatting::hz_choice)
+                       ->with_numbers(CU_Hertz)
+                       ->with_number_string_fn(&Formatting::hz_number)
                        ->with_modifier_at(88));
     slots.emplace_back((new PA_Integer(400, 4, _("Out level"), _("Sets the overall Output level of this block.")))
                        ->with_min_max(-100, 0)
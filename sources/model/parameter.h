@@ -18,6 +18,10 @@ enum Parameter_Position {
     PP_Front, PP_Back,
 };
 
+enum Choice_Unit {
+    CU_None, CU_Hertz, CU_Millisecond, CU_Octave, CU_Note,
+};
+
 class Parameter_Modifiers;
 
 class Parameter_Access {
@@ -35,12 +39,15 @@ public:
     virtual int min() const = 0;
     virtual int max() const = 0;
     virtual std::string to_string(int value) const;
+    // the text of a value, built on first use and kept for the next ones
+    const char *label(int value) const;
 
     const char *name = nullptr;
     const char *description = nullptr;
     std::function<std::string(int)> to_string_fn;
     Parameter_Position position = PP_Front;
     std::unique_ptr<Parameter_Modifiers> modifiers;
+    mutable std::vector<const char *> label_cache;
 };
 
 class Parameter_Modifiers {
@@ -107,6 +114,11 @@ public:
           index(index), size(size), values(std::move(values)) {}
     PA_Choice *with_offset(int offset);
     PA_Choice *with_choice_string_fn(std::function<std::string(const char *)> fn);
+    // attaches the numeric value of each choice, parsed once from the text
+    // and with the suffix "k" for thousands; other choices have none
+    PA_Choice *with_numbers(Choice_Unit unit);
+    PA_Choice *with_numbers(Choice_Unit unit, std::vector<double> numbers);
+    PA_Choice *with_number_string_fn(std::function<std::string(double)> fn);
 
     Parameter_Type type() const override { return PT_Choice; }
     int get(const Patch &pat) const override;
@@ -115,11 +127,15 @@ public:
     int max() const override { return values.size() - 1; }
     int clamp(int value) const;
     std::string to_string(int value) const override;
+    bool has_number(int value) const;
+    double number(int value) const;
 
     unsigned index = 0;
     unsigned size = 0;
     std::vector<const char *> values;
     int offset = 0;
+    Choice_Unit unit = CU_None;
+    std::vector<double> numbers;
 };
 
 class PA_Bits : public Parameter_Access {
@@ -35,6 +35,15 @@ uint8_t Patch::checksum() const
     return sum;
 }
 
+uint64_t Patch::hash() const
+{
+    // FNV-1a
+    uint64_t hash = UINT64_C(14695981039346656037);
+    for (uint8_t byte : raw_data)
+        hash = (hash ^ byte) * UINT64_C(1099511628211);
+    return hash;
+}
+
 std::string Patch::name() const
 {
     const char *name_start = (const char *)&raw_data[8];
@@ -14,6 +14,7 @@ public:
     static Patch create_empty();
     bool valid() const;
     uint8_t checksum() const;
+    uint64_t hash() const;
 
     std::string name() const;
     void name(const char *name);
@@ -28,9 +29,13 @@ public:
 
     Patch slot[max_count];
     std::bitset<max_count> used;
+    // slots modified since the bank was loaded or saved
+    std::bitset<max_count> dirty;
 };
 
 enum Bank_Format {
     RealMajor,
     SystemExclusive,
+    Library,
+    StandardMidiFile,
 };
@@ -0,0 +1,154 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "patch_archive.h"
+#include "patch.h"
+#include "utility/misc.h"
+#include <string>
+#include <string.h>
+
+static_assert(sizeof(Patch) == Patch_Archive::record_size && alignof(Patch) == 1,
+              "records must be viewable as patches");
+
+static const char archive_magic[8] = {'F', 'M', 'P', 'A', 'T', 'L', 'I', 'B'};
+
+bool Patch_Archive::open(FILE *fh)
+{
+    close();
+
+    if (map_.map(fh)) {
+        if (open_data(map_.data(), map_.size()))
+            return true;
+        close();
+        return false;
+    }
+
+    // not mappable, eg. a pipe: read it whole
+    size_t size = 0;
+    size_t count;
+    buffer_.resize(64 * 1024);
+    while ((count = fread(&buffer_[size], 1, buffer_.size() - size, fh)) > 0) {
+        size += count;
+        if (size == buffer_.size())
+            buffer_.resize(2 * size);
+    }
+    if (ferror(fh) || !open_data(buffer_.data(), size)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void Patch_Archive::close()
+{
+    map_.unmap();
+    std::vector<uint8_t>().swap(buffer_);
+    count_ = 0;
+    index_ = nullptr;
+    names_ = nullptr;
+    names_size_ = 0;
+    records_ = nullptr;
+}
+
+bool Patch_Archive::open_data(const uint8_t *data, size_t size)
+{
+    if (size < header_size || memcmp(data, archive_magic, sizeof(archive_magic)) != 0)
+        return false;
+    if (load_u32le(data + 8) != version)
+        return false;
+
+    uint64_t count = load_u32le(data + 12);
+    uint64_t index_offset = load_u64le(data + 16);
+    uint64_t names_offset = load_u64le(data + 24);
+    uint64_t names_size = load_u64le(data + 32);
+    uint64_t records_offset = load_u64le(data + 40);
+
+    // check the ranges, taking care of overflows
+    if (index_offset > size || count > (size - index_offset) / entry_size)
+        return false;
+    if (names_offset > size || names_size > size - names_offset)
+        return false;
+    if (names_size > 0 && data[names_offset + names_size - 1] != '\0')
+        return false;
+    if (records_offset > size || count > (size - records_offset) / record_stride)
+        return false;
+    if (records_offset % record_alignment != 0)
+        return false;
+
+    count_ = count;
+    index_ = data + index_offset;
+    names_ = (const char *)data + names_offset;
+    names_size_ = names_size;
+    records_ = data + records_offset;
+    return true;
+}
+
+const Patch &Patch_Archive::patch(size_t index) const
+{
+    return *reinterpret_cast<const Patch *>(records_ + index * record_stride);
+}
+
+Patch_Archive::Entry Patch_Archive::entry(size_t index) const
+{
+    const uint8_t *p = index_ + index * entry_size;
+    Entry ent;
+    ent.slot = load_u32le(p);
+    uint32_t name_offset = load_u32le(p + 4);
+    ent.hash = load_u64le(p + 8);
+    ent.flags = load_u32le(p + 16);
+    ent.name = (name_offset < names_size_) ? (names_ + name_offset) : "";
+    return ent;
+}
+
+void Patch_Archive::save(const Item *items, size_t count, std::vector<uint8_t> &data)
+{
+    std::string names;
+    std::vector<uint32_t> name_offsets(count);
+    for (size_t i = 0; i < count; ++i) {
+        name_offsets[i] = names.size();
+        names += items[i].patch->name();
+        names.push_back('\0');
+    }
+
+    size_t index_offset = header_size;
+    size_t names_offset = index_offset + count * entry_size;
+    size_t records_offset = names_offset + names.size();
+    records_offset = (records_offset + record_alignment - 1) / record_alignment * record_alignment;
+    size_t total_size = records_offset + count * record_stride;
+
+    data.assign(total_size, 0);
+    uint8_t *p = data.data();
+
+    memcpy(p, archive_magic, sizeof(archive_magic));
+    store_u32le(p + 8, version);
+    store_u32le(p + 12, count);
+    store_u64le(p + 16, index_offset);
+    store_u64le(p + 24, names_offset);
+    store_u64le(p + 32, names.size());
+    store_u64le(p + 40, records_offset);
+
+    for (size_t i = 0; i < count; ++i) {
+        const Patch &pat = *items[i].patch;
+        uint8_t *ent = p + index_offset + i * entry_size;
+        store_u32le(ent, items[i].slot);
+        store_u32le(ent + 4, name_offsets[i]);
+        store_u64le(ent + 8, pat.hash());
+        store_u32le(ent + 16, pat.valid() ? Flag_Valid : 0);
+        memcpy(p + records_offset + i * record_stride, pat.raw_data, record_size);
+    }
+
+    memcpy(p + names_offset, names.data(), names.size());
+}
+
+void Patch_Archive::save_bank(const Patch_Bank &pbank, std::vector<uint8_t> &data)
+{
+    std::vector<Item> items;
+    items.reserve(Patch_Bank::max_count);
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+        if (pbank.used[i])
+            items.push_back(Item{&pbank.slot[i], i});
+    }
+    save(items.data(), items.size(), data);
+}
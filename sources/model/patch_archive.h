@@ -0,0 +1,80 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include "utility/mapped_file.h"
+#include <vector>
+#include <stdio.h>
+#include <stdint.h>
+class Patch;
+class Patch_Bank;
+
+// binary patch library, accessed by memory mapping without parsing
+//
+// layout, in little-endian order:
+//   header, 64 bytes
+//     magic "FMPATLIB", u32 version, u32 count,
+//     u64 index offset, u64 names offset, u64 names size, u64 records offset
+//   index, 24 bytes per patch
+//     u32 slot, u32 name offset, u64 content hash, u32 flags, u32 reserved
+//   names, as nul-terminated strings
+//   records, 612 bytes per patch at a stride of 640, aligned to 64
+class Patch_Archive {
+public:
+    Patch_Archive() {}
+
+    Patch_Archive(const Patch_Archive &) = delete;
+    Patch_Archive &operator=(const Patch_Archive &) = delete;
+
+    enum {
+        version = 1,
+        header_size = 64,
+        entry_size = 24,
+        record_size = 612,
+        record_stride = 640,
+        record_alignment = 64,
+    };
+
+    enum Flag {
+        Flag_Valid = 1,
+    };
+
+    static constexpr uint32_t no_slot = ~(uint32_t)0;
+
+    struct Entry {
+        uint32_t slot;
+        uint32_t flags;
+        uint64_t hash;
+        const char *name;
+    };
+
+    // opens in constant time, checking only the header
+    bool open(FILE *fh);
+    void close();
+
+    size_t size() const { return count_; }
+    const Patch &patch(size_t index) const;
+    Entry entry(size_t index) const;
+
+    struct Item {
+        const Patch *patch;
+        uint32_t slot;
+    };
+
+    static void save(const Item *items, size_t count, std::vector<uint8_t> &data);
+    static void save_bank(const Patch_Bank &pbank, std::vector<uint8_t> &data);
+
+private:
+    bool open_data(const uint8_t *data, size_t size);
+
+private:
+    Mapped_File map_;
+    std::vector<uint8_t> buffer_;
+    size_t count_ = 0;
+    const uint8_t *index_ = nullptr;
+    const char *names_ = nullptr;
+    size_t names_size_ = 0;
+    const uint8_t *records_ = nullptr;
+};
@@ -0,0 +1,125 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "patch_delta.h"
+#include "utility/misc.h"
+#include <algorithm>
+#include <bitset>
+#include <vector>
+#include <string.h>
+
+static_assert(sizeof(Patch::raw_data) % 4 == 0, "the patch must be made of words");
+
+static inline unsigned count_trailing_zeros(uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    unsigned n = 0;
+    for (; !(x & 1); x >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+Patch_Delta::Patch_Delta()
+{
+    memset(baseline_.raw_data, 0, sizeof(baseline_.raw_data));
+    memcpy(base_words_, baseline_.raw_data, sizeof(baseline_.raw_data));
+}
+
+Patch_Delta::Patch_Delta(const Patch &baseline)
+    : baseline_(baseline)
+{
+    memcpy(base_words_, baseline_.raw_data, sizeof(baseline_.raw_data));
+}
+
+size_t Patch_Delta::encode(const Patch &pat, uint8_t *data) const
+{
+    uint32_t words[word_count];
+    memcpy(words, pat.raw_data, sizeof(pat.raw_data));
+
+    // a plain comparison loop, which the compiler vectorizes
+    uint8_t changed[word_count];
+    for (unsigned i = 0; i < word_count; ++i)
+        changed[i] = words[i] != base_words_[i];
+
+    uint32_t bitmap[bitmap_count] = {};
+    for (unsigned i = 0; i < word_count; ++i)
+        bitmap[i / 32] |= (uint32_t)changed[i] << (i % 32);
+
+    uint8_t *p = data;
+    for (unsigned i = 0; i < bitmap_count; ++i) {
+        store_u32le(p, bitmap[i]);
+        p += 4;
+    }
+    // the words are byte sequences of the patch, stored as they are
+    for (unsigned i = 0; i < word_count; ++i) {
+        if (changed[i]) {
+            memcpy(p, &words[i], 4);
+            p += 4;
+        }
+    }
+    return p - data;
+}
+
+void Patch_Delta::decode(const uint8_t *data, Patch &pat) const
+{
+    const uint8_t *src = data + bitmap_size;
+
+    uint32_t words[word_count];
+    memcpy(words, base_words_, sizeof(words));
+
+    // visit the set bits only
+    for (unsigned i = 0; i < bitmap_count; ++i) {
+        for (uint32_t bits = load_u32le(&data[4 * i]); bits; bits &= bits - 1) {
+            memcpy(&words[32 * i + count_trailing_zeros(bits)], src, 4);
+            src += 4;
+        }
+    }
+
+    memcpy(pat.raw_data, words, sizeof(pat.raw_data));
+}
+
+size_t Patch_Delta::record_size(const uint8_t *bitmap)
+{
+    unsigned changed = 0;
+    for (unsigned i = 0; i < bitmap_count; ++i)
+        changed += std::bitset<32>(load_u32le(&bitmap[4 * i])).count();
+
+    // no bits past the last word
+    if (load_u32le(&bitmap[4 * (bitmap_count - 1)]) >> (word_count % 32) != 0)
+        return 0;
+
+    return bitmap_size + 4 * changed;
+}
+
+Patch Patch_Delta::mode_baseline(const Patch *pats, size_t count)
+{
+    Patch baseline;
+    memset(baseline.raw_data, 0, sizeof(baseline.raw_data));
+
+    std::vector<uint32_t> column(count);
+    for (unsigned i = 0; i < word_count; ++i) {
+        for (size_t j = 0; j < count; ++j)
+            memcpy(&column[j], &pats[j].raw_data[4 * i], 4);
+        std::sort(column.begin(), column.end());
+
+        uint32_t best = 0;
+        size_t best_run = 0;
+        for (size_t j = 0, run; j < count; j += run) {
+            run = 1;
+            while (j + run < count && column[j + run] == column[j])
+                ++run;
+            if (run > best_run) {
+                best = column[j];
+                best_run = run;
+            }
+        }
+        memcpy(&baseline.raw_data[4 * i], &best, 4);
+    }
+
+    return baseline;
+}
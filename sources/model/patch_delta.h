@@ -0,0 +1,45 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include "patch.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// encoding of patches as the 4-byte words which differ from a common
+// baseline, with a bitmap of the words present
+//
+// record layout:
+//   bitmap (5 x u32, little-endian), changed words (4 bytes each, as in
+//   the patch)
+class Patch_Delta {
+public:
+    Patch_Delta();
+    explicit Patch_Delta(const Patch &baseline);
+
+    enum {
+        word_count = sizeof(Patch::raw_data) / 4,
+        bitmap_count = (word_count + 31) / 32,
+        bitmap_size = 4 * bitmap_count,
+        max_record_size = bitmap_size + sizeof(Patch::raw_data),
+    };
+
+    const Patch &baseline() const { return baseline_; }
+
+    // encodes into a record of at most max_record_size, returns its size
+    size_t encode(const Patch &pat, uint8_t *data) const;
+    // decodes a record, whose size is given by its bitmap
+    void decode(const uint8_t *data, Patch &pat) const;
+
+    // size of the record from its bitmap, or 0 if the bitmap is invalid
+    static size_t record_size(const uint8_t *bitmap);
+
+    // baseline which is the most frequent value of each word
+    static Patch mode_baseline(const Patch *pats, size_t count);
+
+private:
+    Patch baseline_;
+    uint32_t base_words_[word_count];
+};
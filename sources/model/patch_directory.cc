@@ -0,0 +1,212 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "patch_directory.h"
+#include "patch_stream.h"
+#include "patch_writer.h"
+#include "utility/misc.h"
+#include "utility/parallel.h"
+#include <FL/fl_utf8.h>
+#include <algorithm>
+#include <memory>
+#include <ctype.h>
+#include <string.h>
+#include <stdio.h>
+
+int Patch_Directory::file_format(const std::string &filename)
+{
+    std::string ext = file_name_extension(filename);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) -> char { return tolower((unsigned char)c); });
+
+    if (ext == ".realpatch")
+        return Bank_Format::RealMajor;
+    else if (ext == ".syx")
+        return Bank_Format::SystemExclusive;
+    else if (ext == ".mid" || ext == ".midi")
+        return Bank_Format::StandardMidiFile;
+    return -1;
+}
+
+bool Patch_Directory::list_patch_files(const char *dirname, std::vector<std::string> &filenames, bool recursive)
+{
+    std::vector<std::string> all_filenames;
+    if (!(recursive ? list_files_recursively : list_files)(dirname, all_filenames))
+        return false;
+
+    filenames.clear();
+    for (std::string &filename : all_filenames) {
+        if (file_format(filename) != -1)
+            filenames.push_back(std::move(filename));
+    }
+    return true;
+}
+
+void Patch_Directory::load_patch_files(const std::vector<std::string> &filenames, std::vector<Entry> &entries, const Progress &progress)
+{
+    size_t count = filenames.size();
+    entries.clear();
+    entries.resize(count);
+
+    auto load = [&filenames, &entries](size_t index) {
+                    Entry &ent = entries[index];
+                    ent.filename = filenames[index];
+
+                    FILE_u fh(fl_fopen(ent.filename.c_str(), "rb"));
+                    if (!fh)
+                        return;
+
+                    auto on_patch = [&ent](const Patch &pat) -> bool {
+                                        ent.patch = pat;
+                                        ent.loaded = true;
+                                        return false;
+                                    };
+                    Patch_Stream_Loader::load_file(fh.get(), file_format(ent.filename), on_patch);
+                };
+
+    std::function<void(size_t)> report;
+    if (progress)
+        report = [&progress, count](size_t done) { progress(done, count); };
+
+    parallel_for(count, load, report);
+}
+
+std::string Patch_Directory::slot_file_name(const Patch &pat, unsigned nth, int format)
+{
+    char number[16];
+    sprintf(number, "%02u-", nth + 1);
+
+    std::string name = pat.name();
+    for (char &c : name) {
+        // characters not permitted in file names on some systems
+        if ((unsigned char)c < 32 || strchr("/\\:*?\"<>|", c))
+            c = '_';
+    }
+    while (!name.empty() && (name.back() == '.' || name.back() == ' '))
+        name.pop_back();
+
+    const char *ext = "";
+    switch (format) {
+    case Bank_Format::RealMajor:
+        ext = ".realpatch";
+        break;
+    case Bank_Format::SystemExclusive:
+        ext = ".syx";
+        break;
+    case Bank_Format::StandardMidiFile:
+        ext = ".mid";
+        break;
+    }
+
+    return number + name + ext;
+}
+
+unsigned Patch_Directory::file_slot_number(const std::string &filename)
+{
+    size_t pos = filename.find_last_of("/\\");
+    pos = (pos == filename.npos) ? 0 : (pos + 1);
+
+    unsigned number = 0;
+    size_t digits = 0;
+    for (; pos < filename.size() && digits < 4; ++pos, ++digits) {
+        unsigned digit = (unsigned char)filename[pos] - '0';
+        if (digit >= 10)
+            break;
+        number = number * 10 + digit;
+    }
+
+    if (digits == 0 || pos == filename.size() || filename[pos] != '-')
+        return ~0u;
+    if (number < 1 || number > Patch_Bank::max_count)
+        return ~0u;
+    return number - 1;
+}
+
+bool Patch_Directory::save_bank(const char *dirname, const Patch_Bank &pbank, int format, std::vector<std::string> *failed)
+{
+    std::vector<unsigned> slots;
+    slots.reserve(Patch_Bank::max_count);
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+        if (pbank.used[i])
+            slots.push_back(i);
+    }
+
+    std::string prefix = dirname;
+    if (!prefix.empty() && prefix.back() != '/')
+        prefix.push_back('/');
+
+    size_t count = slots.size();
+    std::unique_ptr<bool[]> success(new bool[count]());
+
+    auto save = [&](size_t index) {
+                    unsigned nth = slots[index];
+                    const Patch &pat = pbank.slot[nth];
+
+                    std::vector<uint8_t> data;
+                    switch (format) {
+                    case Bank_Format::RealMajor:
+                        Patch_Writer::save_realmajor_patch(pat, data);
+                        break;
+                    case Bank_Format::SystemExclusive:
+                        Patch_Writer::save_sysex_patch(pat, data);
+                        break;
+                    case Bank_Format::StandardMidiFile:
+                        Patch_Writer::save_midifile_patch(pat, data);
+                        break;
+                    default:
+                        return;
+                    }
+
+                    std::string filename = prefix + slot_file_name(pat, nth, format);
+                    FILE_u fh(fl_fopen(filename.c_str(), "wb"));
+                    bool ok = fh && fwrite(data.data(), 1, data.size(), fh.get()) == data.size();
+                    ok = fh && fclose(fh.release()) == 0 && ok;
+                    if (!ok)
+                        fl_unlink(filename.c_str());
+                    success[index] = ok;
+                };
+
+    parallel_for(count, save);
+
+    bool all_success = true;
+    for (size_t i = 0; i < count; ++i) {
+        if (!success[i]) {
+            all_success = false;
+            if (failed)
+                failed->push_back(slot_file_name(pbank.slot[slots[i]], slots[i], format));
+        }
+    }
+    return all_success;
+}
+
+bool Patch_Directory::load_bank(const char *dirname, Patch_Bank &pbank, const Progress &progress)
+{
+    std::vector<std::string> filenames;
+    if (!list_patch_files(dirname, filenames, false))
+        return false;
+
+    std::vector<Entry> entries;
+    load_patch_files(filenames, entries, progress);
+
+    std::unique_ptr<Patch_Bank> pbank_tmp(new Patch_Bank);
+    size_t count = 0;
+
+    for (const Entry &ent : entries) {
+        if (!ent.loaded)
+            continue;
+        unsigned patchno = file_slot_number(ent.filename);
+        if (patchno == ~0u)
+            patchno = ent.patch.patch_number();
+        count += !pbank_tmp->used[patchno];
+        pbank_tmp->slot[patchno] = ent.patch;
+        pbank_tmp->slot[patchno].patch_number(patchno);
+        pbank_tmp->used[patchno] = true;
+    }
+
+    if (count == 0)
+        return false;
+
+    pbank = *pbank_tmp;
+    return true;
+}
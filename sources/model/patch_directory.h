@@ -0,0 +1,46 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include "patch.h"
+#include <string>
+#include <vector>
+#include <functional>
+
+// individual patch files of a directory tree
+class Patch_Directory {
+public:
+    struct Entry {
+        std::string filename;
+        Patch patch;
+        bool loaded = false;
+    };
+
+    // receives the count of files processed and the total
+    typedef std::function<void(size_t, size_t)> Progress;
+
+    // format of a patch file according to its extension, or -1
+    static int file_format(const std::string &filename);
+
+    // lists the patch files under a directory, in a deterministic order
+    static bool list_patch_files(const char *dirname, std::vector<std::string> &filenames, bool recursive = true);
+
+    // loads the patch files in parallel, into entries in the same order
+    static void load_patch_files(const std::vector<std::string> &filenames, std::vector<Entry> &entries, const Progress &progress = nullptr);
+
+    // name of the file of a bank slot, as "NN-Name.ext"
+    static std::string slot_file_name(const Patch &pat, unsigned nth, int format);
+
+    // slot number of a file named "NN-Name.ext", or ~0u
+    static unsigned file_slot_number(const std::string &filename);
+
+    // saves the used slots of a bank as individual files, in parallel.
+    // returns false if any file fails, whose names are optionally returned.
+    static bool save_bank(const char *dirname, const Patch_Bank &pbank, int format, std::vector<std::string> *failed = nullptr);
+
+    // loads a bank from the individual files of a directory, in parallel.
+    // files are placed according to their number, or else to the patch.
+    static bool load_bank(const char *dirname, Patch_Bank &pbank, const Progress &progress = nullptr);
+};
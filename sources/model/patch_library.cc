@@ -0,0 +1,58 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "patch_library.h"
+#include <string.h>
+
+Patch_Library::Id Patch_Library::insert(const Patch &pat)
+{
+    Patch norm = normalize(pat);
+    uint64_t hash = norm.hash();
+
+    Id id = find_normalized(norm, hash);
+    if (id != no_id)
+        return id;
+
+    id = count_;
+    if (id % chunk_size == 0)
+        chunks_.emplace_back(new Patch[chunk_size]);
+    chunks_.back()[id % chunk_size] = norm;
+    ++count_;
+
+    index_.emplace(hash, id);
+    return id;
+}
+
+Patch_Library::Id Patch_Library::find(const Patch &pat) const
+{
+    Patch norm = normalize(pat);
+    return find_normalized(norm, norm.hash());
+}
+
+void Patch_Library::clear()
+{
+    chunks_.clear();
+    count_ = 0;
+    index_.clear();
+}
+
+Patch Patch_Library::normalize(const Patch &pat)
+{
+    Patch norm = pat;
+    norm.patch_number(0);
+    return norm;
+}
+
+Patch_Library::Id Patch_Library::find_normalized(const Patch &pat, uint64_t hash) const
+{
+    auto range = index_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        // check against hash collisions
+        Id id = it->second;
+        if (memcmp(get(id).raw_data, pat.raw_data, sizeof(pat.raw_data)) == 0)
+            return id;
+    }
+    return no_id;
+}
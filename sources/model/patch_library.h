@@ -0,0 +1,41 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include "patch.h"
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <stdint.h>
+
+// unbounded store of patches, where identical patches are stored once.
+// patches are kept independently of a slot, with a patch number of 0.
+class Patch_Library {
+public:
+    typedef uint32_t Id;
+    static constexpr Id no_id = ~(Id)0;
+
+    // inserts a patch, or returns the id of the identical one
+    Id insert(const Patch &pat);
+    Id find(const Patch &pat) const;
+
+    const Patch &get(Id id) const
+        { return chunks_[id / chunk_size][id % chunk_size]; }
+    size_t size() const
+        { return count_; }
+
+    void clear();
+
+private:
+    static Patch normalize(const Patch &pat);
+    Id find_normalized(const Patch &pat, uint64_t hash) const;
+
+private:
+    enum { chunk_size = 1024 };
+    // chunks are never moved, so references remain valid
+    std::vector<std::unique_ptr<Patch[]>> chunks_;
+    size_t count_ = 0;
+    std::unordered_multimap<uint64_t, Id> index_;
+};
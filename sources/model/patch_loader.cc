@@ -5,12 +5,56 @@
 
 #include "patch_loader.h"
 #include "patch.h"
+#include "sysex_index.h"
 #include "utility/misc.h"
 #include <FL/fl_utf8.h>
-#include <string>
 #include <string.h>
 #include <stdio.h>
 
+static inline bool is_realmajor_separator(uint8_t c)
+{
+    return c == ',' || c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// extract the decimal numbers of a RealMajor frame, in a single pass over the
+// text and independently of the locale, into a buffer of the given capacity.
+// the numbers are separated by commas and whitespace, and any other character,
+// such as a sign, is invalid. returns the count of numbers, or -1 on invalid
+// or overlong input.
+static long parse_realmajor_numbers(const uint8_t *text, size_t length, uint8_t *dst, size_t capacity)
+{
+    size_t count = 0;
+    unsigned number = 0;
+    bool in_number = false;
+
+    for (size_t i = 0; i < length; ++i) {
+        unsigned digit = (unsigned)text[i] - '0';
+        if (digit < 10) {
+            number = number * 10 + digit;
+            if (number >= 256)
+                return -1;
+            in_number = true;
+        }
+        else if (!is_realmajor_separator(text[i]))
+            return -1;
+        else if (in_number) {
+            if (count == capacity)
+                return -1;
+            dst[count++] = (uint8_t)number;
+            number = 0;
+            in_number = false;
+        }
+    }
+
+    if (in_number) {
+        if (count == capacity)
+            return -1;
+        dst[count++] = (uint8_t)number;
+    }
+
+    return (long)count;
+}
+
 bool Patch_Loader::load_realmajor_patch(const uint8_t *data, size_t length, Patch &pat, const uint8_t **endp)
 {
     const uint8_t *startp = (const uint8_t *)memchr(data, '[', length);
@@ -23,49 +67,54 @@ bool Patch_Loader::load_realmajor_patch(const uint8_t *data, size_t length, Patc
     if (end)
         length = end - data;
     if (endp)
-        *endp = end + 1;
-
-    std::string input((const char *)data, length);
-    std::vector<uint8_t> sysex;
-    sysex.reserve(1024);
+        *endp = end ? (end + 1) : (data + length);
 
-    for (size_t i = 0; i < length; ++i) {
-        unsigned number;
-        unsigned bytecount;
-        if (sscanf(&input.c_str()[i], "%u%n", &number, &bytecount) == 1) {
-            if (number >= 256)
-                return false;
-            sysex.push_back((uint8_t)number);
-            i += bytecount - 1;
-        }
-    }
+    uint8_t sysex[1024];
+    long count = parse_realmajor_numbers(data, length, sysex, sizeof(sysex));
+    if (count < 0)
+        return false;
 
     bool validate_checksum = false;
-    return load_sysex_patch(sysex.data(), sysex.size(), pat, nullptr, validate_checksum);
+    return load_sysex_patch(sysex, (size_t)count, pat, nullptr, validate_checksum);
 }
 
 bool Patch_Loader::load_sysex_patch(const uint8_t *data, size_t length, Patch &pat, const uint8_t **endp, bool validate_checksum)
 {
-    const uint8_t *startp = (const uint8_t *)memchr(data, 0xf0, length);
-    if (!startp)
-        return false;
-    length -= startp - data;
-    data = startp;
-
-    const uint8_t *end = (const uint8_t *)memchr(data + 1, 0xf7, length - 1);
-    if (!end)
-        return false;
-    if (endp)
-        *endp = end + 1;
-    length = end - data;
+    const uint8_t *p = data;
+    const uint8_t *end = data + length;
+
+    // the messages of other devices are skipped
+    for (;;) {
+        const uint8_t *start = (const uint8_t *)memchr(p, 0xf0, end - p);
+        if (!start)
+            return false;
+        const uint8_t *stop = (const uint8_t *)memchr(start + 1, 0xf7, end - (start + 1));
+        if (!stop)
+            return false;
+
+        // a message which is cut short by another is dropped
+        for (const uint8_t *next;
+             (next = (const uint8_t *)memchr(start + 1, 0xf0, stop - (start + 1)));)
+            start = next;
+
+        p = stop + 1;
+        if (load_sysex_payload(start + 1, stop - (start + 1), pat, validate_checksum)) {
+            if (endp)
+                *endp = p;
+            return true;
+        }
+    }
+}
 
-    if (length < 614)
+bool Patch_Loader::load_sysex_payload(const uint8_t *data, size_t length, Patch &pat, bool validate_checksum)
+{
+    if (length < 613 || !Sysex_Index::is_gmajor_patch(data, length))
         return false;
 
     Patch tmp;
-    memcpy(tmp.raw_data, data + 1, 612);
+    memcpy(tmp.raw_data, data, 612);
 
-    bool checksum_ok = data[613] == tmp.checksum();
+    bool checksum_ok = data[612] == tmp.checksum();
     // fprintf(stderr, "Checksum %s\n", checksum_ok ? "good" : "bad");
 
     if (validate_checksum && !checksum_ok)
@@ -98,12 +147,17 @@ bool Patch_Loader::load_realmajor_bank(const uint8_t *data, size_t length, Patch
 
 bool Patch_Loader::load_sysex_bank(const uint8_t *data, size_t length, Patch_Bank &pbank, bool validate_checksum)
 {
-    const uint8_t *curp = data;
+    Sysex_Index index;
+    index.build(data, length);
+
     Patch_Bank pbank_tmp;
     Patch pat_tmp;
     size_t count = 0;
 
-    while (load_sysex_patch(curp, data + length - curp, pat_tmp, &curp, validate_checksum)) {
+    for (const Sysex_Index::Frame &frame : index.frames(Sysex_Index::device_gmajor)) {
+        const uint8_t *payload = data + frame.offset + 1;
+        if (!load_sysex_payload(payload, frame.length - 2, pat_tmp, validate_checksum))
+            continue;
         unsigned patchno = pat_tmp.patch_number();
         count += !pbank_tmp.used[patchno];
         pbank_tmp.slot[patchno] = pat_tmp;
@@ -13,6 +13,9 @@ class Patch_Loader {
 public:
     static bool load_realmajor_patch(const uint8_t *data, size_t length, Patch &pat, const uint8_t **endp = nullptr);
     static bool load_sysex_patch(const uint8_t *data, size_t length, Patch &pat, const uint8_t **endp = nullptr, bool validate_checksum = false);
+    // loads the message which follows the F0 status byte, if it is a patch
+    // of the G-Major
+    static bool load_sysex_payload(const uint8_t *data, size_t length, Patch &pat, bool validate_checksum = false);
 
     static bool load_realmajor_bank(const uint8_t *data, size_t length, Patch_Bank &pbank);
     static bool load_sysex_bank(const uint8_t *data, size_t length, Patch_Bank &pbank, bool validate_checksum = false);
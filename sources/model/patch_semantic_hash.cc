@@ -0,0 +1,213 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "patch_semantic_hash.h"
+#include "parameter.h"
+#include <algorithm>
+#include <iterator>
+#include <string.h>
+
+static void mark_bytes(Patch_Semantic_Hash::Mask &mask, unsigned index, unsigned size, bool value = true)
+{
+    uint8_t *bytes = reinterpret_cast<uint8_t *>(mask.data());
+    memset(&bytes[index], value ? 0xff : 0x00, size);
+}
+
+static void mark_parameter(Patch_Semantic_Hash::Mask &mask, const Parameter_Access &p)
+{
+    switch (p.type()) {
+    case PT_Integer: {
+        const PA_Integer &pi = static_cast<const PA_Integer &>(p);
+        mark_bytes(mask, pi.index, pi.size);
+        break;
+    }
+    case PT_Boolean: {
+        const PA_Boolean &pb = static_cast<const PA_Boolean &>(p);
+        mark_bytes(mask, pb.index, pb.size);
+        break;
+    }
+    case PT_Choice: {
+        const PA_Choice &pc = static_cast<const PA_Choice &>(p);
+        mark_bytes(mask, pc.index, pc.size);
+        break;
+    }
+    case PT_Bits: {
+        const PA_Bits &pb = static_cast<const PA_Bits &>(p);
+        mark_bytes(mask, pb.index, pb.size);
+        break;
+    }
+    }
+
+    if (const Parameter_Modifiers *mod = p.modifiers.get()) {
+        for (const Parameter_Access *pm : {mod->assignment.get(), mod->min.get(), mod->mid.get(), mod->max.get()}) {
+            if (pm)
+                mark_parameter(mask, *pm);
+        }
+    }
+}
+
+static void mark_collection(Patch_Semantic_Hash::Mask &mask, const Parameter_Collection &coll)
+{
+    for (const std::unique_ptr<Parameter_Access> &p : coll.slots)
+        mark_parameter(mask, *p);
+}
+
+static void mask_or(Patch_Semantic_Hash::Mask &dst, const Patch_Semantic_Hash::Mask &src)
+{
+    for (unsigned i = 0; i < Patch_Semantic_Hash::word_count; ++i)
+        dst[i] |= src[i];
+}
+
+Patch_Semantic_Hash::Patch_Semantic_Hash()
+    : pg_(new P_General)
+{
+    P_General &pg = *pg_;
+
+    add_block(pg.enable_compressor(), pg.compressor);
+    add_block(pg.enable_filter(), pg.type_filter(), *pg.filter,
+              {&pg.filter->auto_resonance, &pg.filter->resonance, &pg.filter->vintage_phaser,
+               &pg.filter->smooth_phaser, &pg.filter->tremolo, &pg.filter->panner});
+    add_block(pg.enable_pitch(), pg.type_pitch(), *pg.pitch,
+              {&pg.pitch->detune, &pg.pitch->whammy, &pg.pitch->octaver, &pg.pitch->shifter});
+    add_block(pg.enable_modulator(), pg.type_modulation(), *pg.modulation,
+              {&pg.modulation->classic_chorus, &pg.modulation->advanced_chorus, &pg.modulation->classic_flanger,
+               &pg.modulation->advanced_flanger, &pg.modulation->vibrato});
+    add_block(pg.enable_delay(), pg.type_delay(), *pg.delay,
+              {&pg.delay->ping_pong, &pg.delay->dynamic, &pg.delay->dual});
+    add_block(pg.enable_reverb(), pg.reverb);
+    // the reverb type is not polymorphic, but it belongs to its block
+    mark_parameter(blocks_.back().fixed, pg.type_reverb());
+    add_block(pg.enable_equalizer(), pg.equalizer);
+    add_block(pg.enable_noisegate(), pg.noise_gate);
+
+    // the bytes of all blocks are active only conditionally
+    Mask conditional {};
+    for (const Block &block : blocks_) {
+        mask_or(conditional, block.fixed);
+        for (const auto &variant : block.variants)
+            mask_or(conditional, variant.second);
+    }
+
+    // the bytes which no block claims are kept, to be conservative
+    base_.fill(0);
+    mark_bytes(base_, 0, sizeof(Patch::raw_data));
+    for (unsigned i = 0; i < word_count; ++i)
+        base_[i] &= ~conditional[i];
+
+    // the general parameters, except the block types
+    const Parameter_Access *block_types[] = {
+        &pg.type_filter(), &pg.type_pitch(), &pg.type_modulation(), &pg.type_delay(), &pg.type_reverb(),
+    };
+    for (const std::unique_ptr<Parameter_Access> &p : pg.slots) {
+        if (std::find(std::begin(block_types), std::end(block_types), p.get()) == std::end(block_types))
+            mark_parameter(base_, *p);
+    }
+
+    // the patch number and the name
+    mark_bytes(base_, 6, 2, false);
+    mark_bytes(base_, 8, 20, false);
+}
+
+Patch_Semantic_Hash::~Patch_Semantic_Hash()
+{
+}
+
+void Patch_Semantic_Hash::add_block(const PA_Boolean &enable, const Parameter_Collection &coll)
+{
+    Block block;
+    block.enable = &enable;
+    block.fixed.fill(0);
+    mark_collection(block.fixed, coll);
+    blocks_.push_back(std::move(block));
+}
+
+void Patch_Semantic_Hash::add_block(const PA_Boolean &enable, const PA_Choice &tag, Polymorphic_Parameter_Collection &poly, std::vector<const Parameter_Collection *> variants)
+{
+    Block block;
+    block.enable = &enable;
+    block.poly = &poly;
+    block.fixed.fill(0);
+    mark_parameter(block.fixed, tag);
+    for (const Parameter_Collection *coll : variants) {
+        Mask mask {};
+        mark_collection(mask, *coll);
+        block.variants.emplace_back(coll, mask);
+    }
+    blocks_.push_back(std::move(block));
+}
+
+void Patch_Semantic_Hash::active_mask(const Patch &pat, Mask &mask) const
+{
+    mask = base_;
+
+    for (const Block &block : blocks_) {
+        if (!block.enable->get(pat))
+            continue;
+        mask_or(mask, block.fixed);
+        if (block.poly) {
+            const Parameter_Collection *coll = &block.poly->dispatch(pat);
+            for (const auto &variant : block.variants) {
+                if (variant.first == coll)
+                    mask_or(mask, variant.second);
+            }
+        }
+    }
+}
+
+static inline uint64_t rotl64(uint64_t x, unsigned r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+uint64_t Patch_Semantic_Hash::hash(const Patch &pat) const
+{
+    Mask mask;
+    active_mask(pat, mask);
+
+    Mask words {};
+    memcpy(words.data(), pat.raw_data, sizeof(pat.raw_data));
+
+    // masked rounds over independent lanes, which vectorize
+    const uint64_t prime1 = UINT64_C(0x9E3779B185EBCA87);
+    const uint64_t prime2 = UINT64_C(0xC2B2AE3D27D4EB4F);
+    enum { lanes = 4 };
+    uint64_t acc[lanes] = {prime1 + prime2, prime2, 0, 0 - prime1};
+
+    unsigned i = 0;
+    for (; i + lanes <= word_count; i += lanes) {
+        for (unsigned l = 0; l < lanes; ++l)
+            acc[l] = rotl64(acc[l] + (words[i + l] & mask[i + l]) * prime2, 31) * prime1;
+    }
+    for (unsigned l = 0; i < word_count; ++i, ++l)
+        acc[l] = rotl64(acc[l] + (words[i] & mask[i]) * prime2, 31) * prime1;
+
+    uint64_t hash = rotl64(acc[0], 1) + rotl64(acc[1], 7) + rotl64(acc[2], 12) + rotl64(acc[3], 18);
+
+    // final avalanche
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+bool Patch_Semantic_Hash::equal(const Patch &a, const Patch &b) const
+{
+    Mask mask_a, mask_b;
+    active_mask(a, mask_a);
+    active_mask(b, mask_b);
+    if (mask_a != mask_b)
+        return false;
+
+    Mask words_a {}, words_b {};
+    memcpy(words_a.data(), a.raw_data, sizeof(a.raw_data));
+    memcpy(words_b.data(), b.raw_data, sizeof(b.raw_data));
+
+    uint64_t diff = 0;
+    for (unsigned i = 0; i < word_count; ++i)
+        diff |= (words_a[i] ^ words_b[i]) & mask_a[i];
+    return diff == 0;
+}
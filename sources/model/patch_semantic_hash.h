@@ -0,0 +1,53 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include "patch.h"
+#include <vector>
+#include <array>
+#include <memory>
+#include <stdint.h>
+class P_General;
+class PA_Boolean;
+class PA_Choice;
+class Parameter_Collection;
+class Polymorphic_Parameter_Collection;
+
+// identity of the sound of a patch. it ignores the name and the patch
+// number, and the parameters of the disabled blocks and of the variants
+// which are not selected.
+class Patch_Semantic_Hash {
+public:
+    Patch_Semantic_Hash();
+    ~Patch_Semantic_Hash();
+
+    enum { word_count = (sizeof(Patch::raw_data) + 7) / 8 };
+    typedef std::array<uint64_t, word_count> Mask;
+
+    // mask of the bytes significant to the sound, over the words of the patch
+    void active_mask(const Patch &pat, Mask &mask) const;
+
+    uint64_t hash(const Patch &pat) const;
+    bool equal(const Patch &a, const Patch &b) const;
+
+private:
+    struct Block {
+        const PA_Boolean *enable = nullptr;
+        Polymorphic_Parameter_Collection *poly = nullptr;
+        // bytes which are active when the block is enabled
+        Mask fixed;
+        // bytes of each variant, keyed by the collection which dispatch() returns
+        std::vector<std::pair<const Parameter_Collection *, Mask>> variants;
+    };
+
+    void add_block(const PA_Boolean &enable, const Parameter_Collection &coll);
+    void add_block(const PA_Boolean &enable, const PA_Choice &tag, Polymorphic_Parameter_Collection &poly, std::vector<const Parameter_Collection *> variants);
+
+private:
+    std::unique_ptr<P_General> pg_;
+    // bytes which are always active
+    Mask base_;
+    std::vector<Block> blocks_;
+};
@@ -0,0 +1,171 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "patch_stream.h"
+#include "patch_loader.h"
+#include "patch.h"
+#include "midi_file.h"
+#include "sysex_index.h"
+#include "utility/mapped_file.h"
+#include <string.h>
+
+static constexpr size_t read_chunk_size = 64 * 1024;
+
+Patch_Stream_Loader::Patch_Stream_Loader(int format, bool validate_checksum)
+    : format_(format), validate_checksum_(validate_checksum)
+{
+    switch (format) {
+    case Bank_Format::RealMajor:
+        frame_start_ = '[';
+        frame_end_ = ']';
+        break;
+    case Bank_Format::SystemExclusive:
+        frame_start_ = 0xf0;
+        frame_end_ = 0xf7;
+        break;
+    }
+}
+
+bool Patch_Stream_Loader::feed(const uint8_t *data, size_t length, const Callback &cb)
+{
+    const uint8_t *p = data;
+    const uint8_t *end = data + length;
+
+    if (frame_start_ == frame_end_)  // unknown format
+        return true;
+
+    if (in_frame_) {
+        const uint8_t *stop = (const uint8_t *)memchr(p, frame_end_, end - p);
+        const uint8_t *next = stop ? (stop + 1) : end;
+
+        if (!overlong_frame_ && pending_.size() + (next - p) <= max_frame_size)
+            pending_.insert(pending_.end(), p, next);
+        else {
+            overlong_frame_ = true;
+            pending_.clear();
+        }
+
+        if (!stop)
+            return true;
+
+        in_frame_ = false;
+        p = next;
+
+        bool proceed = true;
+        if (!overlong_frame_)
+            proceed = emit(pending_.data(), pending_.size(), cb);
+        pending_.clear();
+        overlong_frame_ = false;
+        if (!proceed)
+            return false;
+    }
+
+    while (p < end) {
+        const uint8_t *start = (const uint8_t *)memchr(p, frame_start_, end - p);
+        if (!start)
+            break;
+
+        const uint8_t *stop = (const uint8_t *)memchr(start + 1, frame_end_, end - (start + 1));
+        if (!stop) {
+            // keep the partial frame until the next piece of input
+            in_frame_ = true;
+            overlong_frame_ = (size_t)(end - start) > max_frame_size;
+            if (!overlong_frame_)
+                pending_.assign(start, end);
+            break;
+        }
+
+        p = stop + 1;
+        if ((size_t)(p - start) <= max_frame_size && !emit(start, p - start, cb))
+            return false;
+    }
+
+    return true;
+}
+
+// a dump which is entirely in memory is indexed, and only the frames of the
+// G-Major are decoded
+static void load_sysex_dump(const uint8_t *data, size_t length, const Patch_Stream_Loader::Callback &cb, bool validate_checksum)
+{
+    Sysex_Index index;
+    index.build(data, length);
+
+    for (const Sysex_Index::Frame &frame : index.frames(Sysex_Index::device_gmajor)) {
+        Patch pat;
+        const uint8_t *payload = data + frame.offset + 1;
+        if (Patch_Loader::load_sysex_payload(payload, frame.length - 2, pat, validate_checksum) && !cb(pat))
+            return;
+    }
+}
+
+// the tracks of MIDI files are sized chunks, so the file is read as a whole
+static bool load_midifile(FILE *fh, const Patch_Stream_Loader::Callback &cb, bool validate_checksum)
+{
+    auto on_sysex = [&cb, validate_checksum](const uint8_t *data, size_t length) -> bool {
+                        Patch pat;
+                        return !Patch_Loader::load_sysex_payload(data, length, pat, validate_checksum) || cb(pat);
+                    };
+
+    Mapped_File map;
+    if (map.map(fh)) {
+        Midi_File::read_sysex(map.data(), map.size(), on_sysex);
+        return true;
+    }
+
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> buffer(read_chunk_size);
+    size_t count;
+    while ((count = fread(buffer.data(), 1, buffer.size(), fh)) > 0)
+        data.insert(data.end(), buffer.data(), buffer.data() + count);
+    if (ferror(fh))
+        return false;
+
+    Midi_File::read_sysex(data.data(), data.size(), on_sysex);
+    return true;
+}
+
+bool Patch_Stream_Loader::load_file(FILE *fh, int format, const Callback &cb, bool validate_checksum)
+{
+    if (format == Bank_Format::StandardMidiFile)
+        return load_midifile(fh, cb, validate_checksum);
+
+    Patch_Stream_Loader loader(format, validate_checksum);
+
+    Mapped_File map;
+    if (map.map(fh)) {
+        if (format == Bank_Format::SystemExclusive)
+            load_sysex_dump(map.data(), map.size(), cb, validate_checksum);
+        else
+            loader.feed(map.data(), map.size(), cb);
+        return true;
+    }
+
+    std::vector<uint8_t> buffer(read_chunk_size);
+    size_t count;
+    while ((count = fread(buffer.data(), 1, buffer.size(), fh)) > 0) {
+        if (!loader.feed(buffer.data(), count, cb))
+            return true;
+    }
+
+    return !ferror(fh);
+}
+
+bool Patch_Stream_Loader::emit(const uint8_t *frame, size_t length, const Callback &cb)
+{
+    Patch pat;
+    bool loaded = false;
+
+    switch (format_) {
+    case Bank_Format::RealMajor:
+        loaded = Patch_Loader::load_realmajor_patch(frame, length, pat);
+        break;
+    case Bank_Format::SystemExclusive:
+        loaded = Patch_Loader::load_sysex_patch(frame, length, pat, nullptr, validate_checksum_);
+        break;
+    }
+
+    // frames which fail to load are skipped
+    return !loaded || cb(pat);
+}
@@ -0,0 +1,44 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <functional>
+#include <vector>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+class Patch;
+
+// incremental patch loader, which frames the input data fed in arbitrary
+// pieces, and yields every valid patch as soon as its frame is complete
+class Patch_Stream_Loader {
+public:
+    // receives each patch, returns false to stop loading
+    typedef std::function<bool(const Patch &)> Callback;
+
+    explicit Patch_Stream_Loader(int format, bool validate_checksum = false);
+
+    // returns false if the callback has stopped the loading
+    bool feed(const uint8_t *data, size_t length, const Callback &cb);
+
+    // loads a file by mapping it into memory, or by reading it piecewise if
+    // it is not mappable. MIDI files are accepted here, but not by feed().
+    // returns false on read error.
+    static bool load_file(FILE *fh, int format, const Callback &cb, bool validate_checksum = false);
+
+    // longest frame accepted, others are skipped
+    enum { max_frame_size = 64 * 1024 };
+
+private:
+    bool emit(const uint8_t *frame, size_t length, const Callback &cb);
+
+    int format_ = -1;
+    bool validate_checksum_ = false;
+    uint8_t frame_start_ = 0;
+    uint8_t frame_end_ = 0;
+    bool in_frame_ = false;
+    bool overlong_frame_ = false;
+    std::vector<uint8_t> pending_;
+};
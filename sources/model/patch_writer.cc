@@ -5,32 +5,86 @@
 
 #include "patch_writer.h"
 #include "patch.h"
+#include "midi_file.h"
 #include "utility/misc.h"
 #include <FL/fl_utf8.h>
 #include <string.h>
 #include <stdio.h>
 
+// pause between the sysex messages of MIDI files, for the device to process them
+static constexpr double midifile_sysex_interval = 0.100;
+
+namespace {
+
+// decimal representations of all byte values, for the RealMajor emitter
+struct Decimal_Table {
+    Decimal_Table();
+    uint8_t length[256];
+    char digits[256][3];
+};
+
+Decimal_Table::Decimal_Table()
+{
+    for (unsigned i = 0; i < 256; ++i) {
+        unsigned n = (i >= 100) ? 3 : (i >= 10) ? 2 : 1;
+        length[i] = n;
+        for (unsigned v = i, j = n; j-- > 0; v /= 10)
+            digits[i][j] = '0' + v % 10;
+    }
+}
+
+const Decimal_Table decimal_table;
+
+}  // namespace
+
+// the RealMajor text is "[240, <612 bytes>, <checksum>, 247, 0]\n"
+static size_t realmajor_patch_size(const Patch &pat, uint8_t checksum)
+{
+    const Decimal_Table &tab = decimal_table;
+    size_t size = 4 + (2 + tab.length[checksum]) + 5 + 3 + 2;
+    for (uint8_t byte : pat.raw_data)
+        size += 2 + tab.length[byte];
+    return size;
+}
+
+static uint8_t *write_realmajor_patch(const Patch &pat, uint8_t checksum, uint8_t *dst)
+{
+    const Decimal_Table &tab = decimal_table;
+
+    auto put = [&tab](uint8_t *dst, uint8_t byte) -> uint8_t * {
+                   // the digit copy may spill over the next 2 bytes, which
+                   // are always overwritten later by the next separator
+                   // or by the closing bracket
+                   unsigned n = tab.length[byte];
+                   dst[0] = ',';
+                   dst[1] = ' ';
+                   memcpy(dst + 2, tab.digits[byte], 3);
+                   return dst + 2 + n;
+               };
+
+    memcpy(dst, "[240", 4);
+    dst += 4;
+    for (uint8_t byte : pat.raw_data)
+        dst = put(dst, byte);
+    dst = put(dst, checksum);
+    dst = put(dst, 0xf7);
+    dst = put(dst, 0);
+    dst[0] = ']';
+    dst[1] = '\n';
+    return dst + 2;
+}
+
 void Patch_Writer::save_realmajor_patch(const Patch &pat, std::vector<uint8_t> &data, bool append)
 {
     if (!append)
         data.clear();
 
-    const char *start = "[240";
-    std::copy(start, start + 4, std::back_inserter(data));
-
-    for (uint8_t byte : pat.raw_data) {
-        char str[8];
-        sprintf(str, ", %u", byte);
-        std::copy(str, str + strlen(str), std::back_inserter(data));
-    }
-    for (unsigned byte : {(unsigned)pat.checksum(), 0xf7u, 0u}) {
-        char str[8];
-        sprintf(str, ", %u", byte);
-        std::copy(str, str + strlen(str), std::back_inserter(data));
-    }
+    uint8_t checksum = pat.checksum();
+    size_t pos = data.size();
+    size_t size = realmajor_patch_size(pat, checksum);
 
-    data.push_back(']');
-    data.push_back('\n');
+    data.resize(pos + size);
+    write_realmajor_patch(pat, checksum, &data[pos]);
 }
 
 void Patch_Writer::save_sysex_patch(const Patch &pat, std::vector<uint8_t> &data, bool append)
@@ -38,7 +92,7 @@ void Patch_Writer::save_sysex_patch(const Patch &pat, std::vector<uint8_t> &data
     if (!append)
         data.clear();
 
-    data.reserve(615);
+    data.reserve(data.size() + 615);
     data.push_back(0xf0);
     for (uint8_t byte : pat.raw_data)
         data.push_back(byte);
@@ -48,20 +102,47 @@ void Patch_Writer::save_sysex_patch(const Patch &pat, std::vector<uint8_t> &data
 
 void Patch_Writer::save_realmajor_bank(const Patch_Bank &pbank, std::vector<uint8_t> &data)
 {
+    uint8_t checksums[Patch_Bank::max_count];
+    size_t size = 0;
+
+    for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+        if (pbank.used[i]) {
+            checksums[i] = pbank.slot[i].checksum();
+            size += realmajor_patch_size(pbank.slot[i], checksums[i]);
+        }
+    }
+
     data.clear();
+    data.resize(size);
 
+    uint8_t *dst = data.data();
     for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
         if (pbank.used[i])
-            save_realmajor_patch(pbank.slot[i], data, true);
+            dst = write_realmajor_patch(pbank.slot[i], checksums[i], dst);
     }
 }
 
 void Patch_Writer::save_sysex_bank(const Patch_Bank &pbank, std::vector<uint8_t> &data)
 {
     data.clear();
+    data.reserve(pbank.used.count() * 615);
 
     for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
         if (pbank.used[i])
             save_sysex_patch(pbank.slot[i], data, true);
     }
 }
+
+void Patch_Writer::save_midifile_patch(const Patch &pat, std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> sysex;
+    save_sysex_patch(pat, sysex);
+    Midi_File::write_sysex(sysex.data(), sysex.size(), midifile_sysex_interval, data);
+}
+
+void Patch_Writer::save_midifile_bank(const Patch_Bank &pbank, std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> sysex;
+    save_sysex_bank(pbank, sysex);
+    Midi_File::write_sysex(sysex.data(), sysex.size(), midifile_sysex_interval, data);
+}
@@ -13,7 +13,9 @@ class Patch_Writer {
 public:
     static void save_realmajor_patch(const Patch &pat, std::vector<uint8_t> &data, bool append = false);
     static void save_sysex_patch(const Patch &pat, std::vector<uint8_t> &data, bool append = false);
+    static void save_midifile_patch(const Patch &pat, std::vector<uint8_t> &data);
 
     static void save_realmajor_bank(const Patch_Bank &pbank, std::vector<uint8_t> &data);
     static void save_sysex_bank(const Patch_Bank &pbank, std::vector<uint8_t> &data);
+    static void save_midifile_bank(const Patch_Bank &pbank, std::vector<uint8_t> &data);
 };
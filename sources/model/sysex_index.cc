@@ -0,0 +1,93 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "sysex_index.h"
+#include <algorithm>
+#include <string.h>
+
+// TC Electronic, then the device id, the model and the message type
+static const uint8_t tc_electronic_id[3] = {0x00, 0x20, 0x1f};
+static constexpr uint8_t gmajor_model = 0x48;
+static constexpr uint8_t gmajor_patch_message = 0x20;
+
+void Sysex_Index::build(const uint8_t *data, size_t length)
+{
+    clear();
+
+    const uint8_t *p = data;
+    const uint8_t *end = data + length;
+
+    while (p < end) {
+        const uint8_t *start = (const uint8_t *)memchr(p, 0xf0, end - p);
+        if (!start)
+            break;
+        const uint8_t *stop = (const uint8_t *)memchr(start + 1, 0xf7, end - (start + 1));
+        if (!stop)
+            break;
+
+        // a message which is cut short by another is dropped
+        for (const uint8_t *next;
+             (next = (const uint8_t *)memchr(start + 1, 0xf0, stop - (start + 1)));)
+            start = next;
+
+        p = stop + 1;
+
+        Frame frame;
+        frame.offset = start - data;
+        frame.length = p - start;
+        uint32_t device = device_of(start + 1, frame.length - 1);
+        devices_[device].push_back(frame);
+        ++frame_count_;
+    }
+}
+
+void Sysex_Index::clear()
+{
+    frame_count_ = 0;
+    devices_.clear();
+}
+
+std::vector<uint32_t> Sysex_Index::devices() const
+{
+    std::vector<uint32_t> keys;
+    keys.reserve(devices_.size());
+    for (const auto &kv : devices_)
+        keys.push_back(kv.first);
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+const std::vector<Sysex_Index::Frame> &Sysex_Index::frames(uint32_t device) const
+{
+    static const std::vector<Frame> none;
+    auto it = devices_.find(device);
+    return (it != devices_.end()) ? it->second : none;
+}
+
+uint32_t Sysex_Index::device_of(const uint8_t *payload, size_t length)
+{
+    if (length < 1 || payload[0] >= 0x80)
+        return device_unknown;
+
+    // the manufacturer id is 1 byte, or 0 followed by 2 bytes
+    if (payload[0] != 0)
+        return (uint32_t)payload[0] << 8;
+    if (length < 3)
+        return device_unknown;
+    uint32_t manufacturer = 0x10000u | (payload[1] << 8) | payload[2];
+
+    uint8_t model = 0;
+    if (memcmp(payload, tc_electronic_id, sizeof(tc_electronic_id)) == 0 && length >= 5)
+        model = payload[4];
+    return (manufacturer << 8) | model;
+}
+
+bool Sysex_Index::is_gmajor_patch(const uint8_t *payload, size_t length)
+{
+    // the device id at byte 3 is the one set by the user, any is accepted
+    return length >= 6 &&
+        memcmp(payload, tc_electronic_id, sizeof(tc_electronic_id)) == 0 &&
+        payload[4] == gmajor_model && payload[5] == gmajor_patch_message;
+}
@@ -0,0 +1,44 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <stddef.h>
+#include <stdint.h>
+
+// index of the sysex messages of a dump, grouped by the device which they
+// are intended for, such as the dumps of a rig of several devices
+class Sysex_Index {
+public:
+    // a complete message, from F0 to F7
+    struct Frame {
+        size_t offset;
+        size_t length;
+    };
+
+    // the device key is the manufacturer id, in the upper bits, and the
+    // model byte for the manufacturers whose layout is known
+    enum : uint32_t {
+        device_unknown = 0,
+        device_gmajor = ((0x10000u | 0x201f) << 8) | 0x48,
+    };
+
+    void build(const uint8_t *data, size_t length);
+    void clear();
+
+    size_t frame_count() const { return frame_count_; }
+    std::vector<uint32_t> devices() const;
+    const std::vector<Frame> &frames(uint32_t device) const;
+
+    // identifies the device of the bytes which follow the F0 status
+    static uint32_t device_of(const uint8_t *payload, size_t length);
+    // checks the header of a patch dump of the G-Major
+    static bool is_gmajor_patch(const uint8_t *payload, size_t length);
+
+private:
+    size_t frame_count_ = 0;
+    std::unordered_map<uint32_t, std::vector<Frame>> devices_;
+};
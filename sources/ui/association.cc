@@ -37,10 +37,17 @@ void Association::update_value(const Patch &pat)
         break;
     }
 
-    for (Fl_Widget *w : name_labels)
-        w->copy_label(access->name);
-    for (Fl_Widget *w : value_labels)
-        w->copy_label(access->to_string(pv).c_str());
+    // the texts outlive the widgets, which can refer to them
+    const char *name = access->name;
+    const char *text = access->label(pv);
+    for (Fl_Widget *w : name_labels) {
+        if (w->label() != name)
+            w->label(name);
+    }
+    for (Fl_Widget *w : value_labels) {
+        if (w->label() != text)
+            w->label(text);
+    }
 }
 
 void Association::update_from_widget(Patch &pat)
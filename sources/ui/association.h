@@ -4,7 +4,7 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #pragma once
-#include <list>
+#include <vector>
 class Parameter_Access;
 class Fl_Group;
 class Fl_Widget;
@@ -18,8 +18,28 @@ enum Association_Kind {
     Assoc_Slider,
 };
 
-enum Association_Flag {
-    Assoc_Refresh_Full =   1 << 0,
+// regions of the patch display, which are rebuilt separately
+enum Display_Region {
+    Region_General =          1 << 0,
+    Region_Compressor =       1 << 1,
+    Region_Equalizer =        1 << 2,
+    Region_Noise_Gate =       1 << 3,
+    Region_Reverb =           1 << 4,
+    Region_Pitch =            1 << 5,
+    Region_Delay =            1 << 6,
+    Region_Filter =           1 << 7,
+    Region_Modulation =       1 << 8,
+    Region_Eq_Curve =         1 << 9,
+    Region_Matrix =           1 << 10,
+    Region_Modifiers_Filter = 1 << 11,
+    Region_Modifiers_Pitch =  1 << 12,
+    Region_Modifiers_Modulation = 1 << 13,
+    Region_Modifiers_Delay =  1 << 14,
+    Region_Modifiers_Reverb = 1 << 15,
+    Region_Modifiers =        Region_Modifiers_Filter|Region_Modifiers_Pitch|
+                              Region_Modifiers_Modulation|Region_Modifiers_Delay|
+                              Region_Modifiers_Reverb,
+    Region_All =              (1 << 16) - 1,
 };
 
 struct Association {
@@ -27,9 +47,13 @@ struct Association {
     Fl_Group *group_box = nullptr;
     Fl_Widget *value_widget = nullptr;
     Association_Kind kind = Assoc_Undefined;
-    int flags = 0;
-    std::list<Fl_Widget *> value_labels;
-    std::list<Fl_Widget *> name_labels;
+    // region of the control, and regions which depend on its value
+    int region = 0;
+    int dependents = 0;
+    // whether it belongs to the controls of the displayed patch
+    bool active = false;
+    std::vector<Fl_Widget *> value_labels;
+    std::vector<Fl_Widget *> name_labels;
     void update_value(const Patch &pat);
     void update_from_widget(Patch &pat);
 };
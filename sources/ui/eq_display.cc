@@ -27,8 +27,6 @@ void Eq_Display::draw()
     if (w <= 0)
         return;
 
-    create_plotdata(w);
-
     fl_push_clip(x, y, w, h);
 
     fl_color(0x20, 0x4a, 0x87);
@@ -57,6 +55,8 @@ void Eq_Display::draw()
     }
 
     if (enable_) {
+        create_plotdata(w);
+
         fl_color(0xff, 0x00, 0x00);
         const double *plotdata = plotdata_.data();
 
@@ -73,75 +73,78 @@ void Eq_Display::draw()
 
 void Eq_Display::set_bands(bool enable, const Band bands[], unsigned count)
 {
+    auto same_band = [](const Band &a, const Band &b) -> bool {
+                         return a.freq == b.freq && a.gain == b.gain && a.width == b.width;
+                     };
+
+    // the curve is kept while the bands do not change
+    if (enable == enable_ && count == bands_.size() &&
+        std::equal(bands, bands + count, bands_.begin(), same_band))
+        return;
+
     enable_ = enable;
     bands_.assign(bands, bands + count);
-    plotdata_.clear();
+    plot_valid_ = false;
     redraw();
 }
 
-static double gauss(double x, double s)
-{
-    auto sqr = [](double x) -> double { return x * x; };
-    return (1.0 / (s * sqrt(2 * M_PI))) * exp(-0.5 * sqr(x / s));
-}
-
-static double norm_gauss(double x, double s)
-{
-    return gauss(x, s) / gauss(0, s);
-}
-
-static constexpr double sigma = 0.85;
+// the sample rate of the G-Major
+static constexpr double sample_rate = 44100.0;
 
 void Eq_Display::create_plotdata(unsigned size)
 {
-    std::vector<double> &plotdata = plotdata_;
-    plotdata.resize(size);
+    if (plot_valid_ && plotdata_.size() == size)
+        return;
 
-    const Band *bands = bands_.data();
-    unsigned num_bands = bands_.size();
+    // the frequency axis depends only on the width, it is kept as the
+    // term sin^2(w/2) of each coordinate which the responses are made of
+    std::vector<double> &phis = phis_;
+    if (phis.size() != size) {
+        phis.resize(size);
+        for (unsigned i = 0; i < size; ++i) {
+            double s = sin(M_PI * coord2freq(i, size) / sample_rate);
+            phis[i] = s * s;
+        }
+    }
 
-    for (unsigned i = 0; i < size; ++i)
-        plotdata[i] = 1.0;
+    std::vector<double> &plotdata = plotdata_;
+    plotdata.assign(size, 1.0);
 
-    for (unsigned i_band = 0; i_band < num_bands; ++i_band) {
-        if (bands[i_band].freq < 0.0)
+    // each band is a peaking biquad, of which the squared magnitudes
+    // multiply; the response is then taken in dB, in units of 12 dB
+    for (const Band &band : bands_) {
+        if (band.freq < 0.0 || band.gain == 1.0)
             continue;
 
+        double a = sqrt(band.gain);
+        double w0 = 2.0 * M_PI * band.freq / sample_rate;
+        double sw0 = sin(w0);
+        double alpha = sw0 * sinh(0.5 * M_LN2 * band.width * w0 / sw0);
+        double c = -2.0 * cos(w0);
+
+        double b0 = 1.0 + alpha * a, b1 = c, b2 = 1.0 - alpha * a;
+        double a0 = 1.0 + alpha / a, a1 = c, a2 = 1.0 - alpha / a;
+
+        // |H|^2 = N(phi) / D(phi), as quadratics in phi
+        double n0 = (b0 + b1 + b2) * (b0 + b1 + b2);
+        double n1 = -4.0 * (b0 * b1 + 4.0 * b0 * b2 + b1 * b2);
+        double n2 = 16.0 * b0 * b2;
+        double d0 = (a0 + a1 + a2) * (a0 + a1 + a2);
+        double d1 = -4.0 * (a0 * a1 + 4.0 * a0 * a2 + a1 * a2);
+        double d2 = 16.0 * a0 * a2;
+
+        const double *phi = phis.data();
+        double *p = plotdata.data();
         for (unsigned i = 0; i < size; ++i) {
-            double f = coord2freq(i, size);
-            double v = eval(i_band, f);
-            plotdata[i] *= v;
+            double x = phi[i];
+            p[i] *= (n0 + x * (n1 + x * n2)) / (d0 + x * (d1 + x * d2));
         }
     }
 
-    for (unsigned i = 0; i < size; ++i) {
-        double db = 20.0 * log10(plotdata[i]);
-        plotdata[i] = db * (1.0 / 12.0);
-    }
-}
-
-double Eq_Display::eval(unsigned band, double freq)
-{
-    if (band >= bands_.size())
-        return 1.0;
-
-    double fcutoff = bands_[band].freq;
-    if (fcutoff < 0.0)
-        return 1.0;
-
-    double gain = bands_[band].gain;
-    double width = bands_[band].width;
-
-    double fc2 = fcutoff * exp2(0.5 * width);
-    double fc1 = fcutoff - (fc2 - fcutoff);
-
-    double x = 2.0 * (freq - fc1) / (fc2 - fc1) - 1.0;
-    double g = norm_gauss(x, sigma);
-
-    double gaindb = 20.0 * log10(gain);
-    double resultdb = gaindb * g;
+    for (unsigned i = 0; i < size; ++i)
+        plotdata[i] = 10.0 * log10(plotdata[i]) * (1.0 / 12.0);
 
-    return pow(10.0, 0.05 * resultdb);
+    plot_valid_ = true;
 }
 
 static const double lx1 = log10(10.0);
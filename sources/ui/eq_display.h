@@ -24,9 +24,10 @@ public:
 private:
     bool enable_ = false;
     std::vector<Band> bands_;
+    std::vector<double> phis_;
     std::vector<double> plotdata_;
+    bool plot_valid_ = false;
     void create_plotdata(unsigned size);
-    double eval(unsigned band, double freq);
     double coord2freq(unsigned i, unsigned n);
     unsigned freq2coord(double f, unsigned n);
 };
@@ -10,12 +10,14 @@
 #include "widget_ex.h"
 #include "model/patch.h"
 #include "model/parameter.h"
+#include "model/bank_file.h"
+#include "model/edit_journal.h"
 #include <FL/filename.H>
 
-void Main_Component::cb_br_bank_i(Fl_Hold_Browser*, void*) {
+void Main_Component::cb_br_bank_i(Patch_Browser*, void*) {
   on_selected_patch();
 }
-void Main_Component::cb_br_bank(Fl_Hold_Browser* o, void* v) {
+void Main_Component::cb_br_bank(Patch_Browser* o, void* v) {
   ((Main_Component*)(o->parent()))->cb_br_bank_i(o,v);
 }
 
@@ -132,7 +134,7 @@ void Main_Component::cb_btn_modifiers(Fl_Button* o, void* v) {
 }
 Main_Component::Main_Component(int X, int Y, int W, int H, const char *L)
   : Fl_Group(X, Y, W, H, L) {
-{ br_bank = new Fl_Hold_Browser(240, 10, 205, 95);
+{ br_bank = new Patch_Browser(240, 10, 205, 95);
   br_bank->box(FL_NO_BOX);
   br_bank->color(FL_BACKGROUND2_COLOR);
   br_bank->selection_color(FL_SELECTION_COLOR);
@@ -144,7 +146,7 @@ Main_Component::Main_Component(int X, int Y, int W, int H, const char *L)
   br_bank->callback((Fl_Callback*)cb_br_bank);
   br_bank->align(Fl_Align(FL_ALIGN_BOTTOM));
   br_bank->when(FL_WHEN_RELEASE_ALWAYS);
-} // Fl_Hold_Browser* br_bank
+} // Patch_Browser* br_bank
 { Fl_Group* o = new Fl_Group(0, 225, 261, 225);
   o->box(FL_THIN_UP_BOX);
   { chk_noise_gate = new Fl_Check_Button_Ex(1, 226, 128, 23, _("Noise gate"));
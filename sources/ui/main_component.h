@@ -4,12 +4,13 @@
 #define main_component_h
 #include <FL/Fl.H>
 #include <FL/Fl_Check_Button.H>
-#include <FL/Fl_Hold_Browser.H>
+#include "patch_browser.h"
 #include <FL/Fl_Slider.H>
 #include <FL/Fl_Double_Window.H>
 #include <list>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 class Patch;
 class Patch_Bank;
 class Parameter_Collection;
@@ -21,9 +22,12 @@ class P_General;
 class Association;
 class Midi_Out_Queue;
 class Modifiers_Editor;
+class Single_Mod_Editor;
 class Eq_Display;
 class Matrix_Display;
 class Hyperlink_Button;
+class Bank_File;
+class Edit_Journal;
 class Fl_Choice;
 class Fl_Check_Button;
 class Fl_Slider;
@@ -55,15 +59,22 @@ private:
   void set_patch_number(unsigned no); 
 public:
   void set_nth_patch(unsigned nth, const Patch &pat); 
+private:
+  void edited_slot(unsigned nth, const Patch &before, bool was_used); 
+public:
   void load_bank_file(const char *filename, int format = -1); 
+  bool recover_journal(); 
   void refresh_bank_browser(); 
-  void refresh_patch_display(); 
+  void refresh_bank_browser_row(unsigned nth); 
+  void refresh_patch_display(int regions = ~0); 
 private:
-  Association *setup_slider(Fl_Slider_Ex *sl, Parameter_Access &p, int flags = 0); 
-  void setup_checkbox(Fl_Check_Button_Ex *chk, Parameter_Access &p, int flags = 0); 
-  void setup_choice(Fl_Choice_Ex *cb, Parameter_Access &p, int flags = 0); 
-  void setup_boxes(bool enable, const Parameter_Collection &pc, Fl_Group_Ex *boxes[], unsigned nboxes); 
-  void setup_modifier_row(const char *title, bool enable, int row, Parameter_Collection &pc); 
+  Association *pooled_association(Fl_Widget *w); 
+  Association *find_association(Fl_Widget *w) const; 
+  Association *setup_slider(Fl_Slider_Ex *sl, Parameter_Access &p, int dependents = 0); 
+  void setup_checkbox(Fl_Check_Button_Ex *chk, Parameter_Access &p, int dependents = 0); 
+  void setup_choice(Fl_Choice_Ex *cb, Parameter_Access &p, int dependents = 0); 
+  void setup_boxes(bool enable, const Parameter_Collection &pc, Fl_Group_Ex *boxes[], unsigned nboxes, int region, int dependents = 0); 
+  void setup_modifier_row(const char *title, bool enable, int row, Parameter_Collection &pc, int region); 
   void on_selected_patch(); 
   void on_changed_midi_interface(); 
   void after_changed_midi_interface(); 
@@ -71,15 +82,26 @@ private:
   void on_change_midi_in(); 
   void on_clicked_import(); 
   void on_clicked_export(); 
+  void import_patch_file(); 
+  void import_patch_folder(bool skip_duplicates); 
+  void import_bank_folder(); 
+  void show_import_progress(size_t done, size_t total); 
+  void export_patch_file(); 
+  void export_bank_folder(int format); 
   void on_clicked_change(); 
   void on_clicked_load(); 
+  void load_bank_dialog(); 
+  void load_bank_revision(); 
+  void load_factory_bank(); 
   void on_clicked_save(); 
+  void save_bank_dialog(bool start_history); 
   void on_clicked_new(); 
   void on_clicked_copy(); 
   void on_clicked_delete(); 
   void on_clicked_receive(); 
   void on_clicked_send(); 
   void on_clicked_modifiers(); 
+  void create_modifiers_window(); 
   void on_edited_patch_name(); 
   static void on_edited_parameter(Fl_Widget *w, void *user_data); 
   static void on_enter_parameter_control(Fl_Widget *w, void *user_data); 
@@ -87,17 +109,23 @@ private:
   void update_eq_display(); 
   void update_matrix_display(); 
 public:
-  Fl_Hold_Browser *br_bank;
+  Patch_Browser *br_bank;
 private:
-  inline void cb_br_bank_i(Fl_Hold_Browser*, void*);
-  static void cb_br_bank(Fl_Hold_Browser*, void*);
+  inline void cb_br_bank_i(Patch_Browser*, void*);
+  static void cb_br_bank(Patch_Browser*, void*);
   std::unique_ptr<Patch_Bank> pbank_; 
   std::unique_ptr<P_General> pgen_; 
-  std::vector<std::unique_ptr<Association>> assoc_; 
+  std::vector<std::unique_ptr<Association>> assoc_pool_; 
+  std::unordered_map<const Fl_Widget *, Association *> assoc_index_; 
+  std::vector<Association *> assoc_; 
+  std::unordered_map<const Fl_Group *, Single_Mod_Editor *> mod_editors_; 
   std::list<Association *> assoc_entered_; 
   std::unique_ptr<Midi_Out_Queue> midi_out_q_; 
   std::unique_ptr<Fl_Double_Window> win_modifiers_; 
   Modifiers_Editor *edt_modifiers_ = nullptr; 
+  int stale_modifiers_ = 0; 
+  std::unique_ptr<Bank_File> bank_file_; 
+  std::unique_ptr<Edit_Journal> journal_; 
 public:
   Fl_Check_Button_Ex *chk_noise_gate;
   Fl_Group_Ex *box_ng1;
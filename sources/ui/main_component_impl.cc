@@ -17,6 +17,15 @@
 #include "model/patch.h"
 #include "model/patch_loader.h"
 #include "model/patch_writer.h"
+#include "model/patch_stream.h"
+#include "model/patch_archive.h"
+#include "model/patch_library.h"
+#include "model/patch_semantic_hash.h"
+#include "model/patch_directory.h"
+#include "model/bank_history.h"
+#include "model/bank_file.h"
+#include "model/factory_bank.h"
+#include "model/edit_journal.h"
 #include "model/parameter.h"
 #include "device/midi.h"
 #include "device/midi_apis.h"
@@ -26,27 +35,30 @@
 #include <FL/Fl_Double_Window.H>
 #include <FL/fl_ask.H>
 #include <array>
+#include <unordered_map>
 #include <algorithm>
 #include <math.h>
+#include <time.h>
 #include <assert.h>
 
 static constexpr double sysex_send_interval = 0.100;
 
+static void format_bank_row(char *text, size_t size, unsigned nth, const Patch &pat)
+{
+    snprintf(text, size, "%u - %s", nth + 1, pat.name().c_str());
+}
+
 void Main_Component::init()
 {
     reset_description_text();
 
-    Fl_Double_Window *win_modifiers = new Fl_Double_Window(810, 635);
-    win_modifiers_.reset(win_modifiers);
-    win_modifiers->label(_("Modifiers"));
-
-    win_modifiers->begin();
-    Modifiers_Editor *edt_modifiers = new Modifiers_Editor(0, 0, win_modifiers->w(), win_modifiers->h());
-    edt_modifiers_ = edt_modifiers;
-    win_modifiers->end();
+    // the modifiers window is made when first shown
+    stale_modifiers_ = Region_Modifiers;
 
     Patch_Bank *pbank = new Patch_Bank;
     pbank_.reset(pbank);
+    bank_file_.reset(new Bank_File);
+    journal_.reset(new Edit_Journal);
 
     P_General *pgen = new P_General;
     pgen_.reset(pgen);
@@ -76,6 +88,8 @@ void Main_Component::init()
 
 Main_Component::~Main_Component()
 {
+    // the session ends normally, nothing to recover
+    journal_->discard();
 }
 
 void Main_Component::reset_description_text()
@@ -95,10 +109,7 @@ void Main_Component::reset_description_text()
 
 unsigned Main_Component::get_patch_number() const
 {
-    int value = br_bank->value();
-    if (value == 0)
-        return ~0u;
-    return (unsigned)(uintptr_t)br_bank->data(value);
+    return br_bank->value();
 }
 
 void Main_Component::set_patch_number(unsigned no)
@@ -108,20 +119,14 @@ void Main_Component::set_patch_number(unsigned no)
         return;
     }
 
-    Fl_Browser &br = *br_bank;
+    Patch_Browser &br = *br_bank;
 
     if (no == ~0u) {
-        br.value(0);
+        br.value(~0u);
         return;
     }
 
-    unsigned nth = 0;
-    for (unsigned i = 1, n = br.size(); nth == 0 && i <= n; ++i) {
-        if ((uintptr_t)br.data(i) == no)
-            nth = i;
-    }
-
-    br.value(nth);
+    br.value(no);
     refresh_patch_display();
 }
 
@@ -131,25 +136,43 @@ void Main_Component::set_nth_patch(unsigned nth, const Patch &pat)
         return;
 
     Patch_Bank &pbank = *pbank_;
+    Patch before = pbank.slot[nth];
+    bool was_used = pbank.used[nth];
     pbank.slot[nth] = pat;
     pbank.slot[nth].patch_number(nth);
     pbank.used.set(nth);
+    edited_slot(nth, before, was_used);
 
-    unsigned patchno = get_patch_number();
-    refresh_bank_browser();
-    set_patch_number(patchno);
+    refresh_bank_browser_row(nth);
+    if (nth == get_patch_number())
+        refresh_patch_display();
+}
+
+void Main_Component::edited_slot(unsigned nth, const Patch &before, bool was_used)
+{
+    Patch_Bank &pbank = *pbank_;
+    pbank.dirty.set(nth);
+
+    // journal the changes, in case of crash
+    journal_->write_patch(nth, before, pbank.slot[nth]);
+    if (pbank.used[nth] != was_used)
+        journal_->write_used(nth, pbank.used[nth]);
 }
 
 void Main_Component::load_bank_file(const char *filename, int format)
 {
-    std::vector<uint8_t> filedata;
+    if (!Bank_File::recover(filename)) {
+        fl_message_title(_("Error"));
+        fl_alert("%s", _("Could not complete the interrupted save of the bank file."));
+        return;
+    }
+
     FILE_u fh(fl_fopen(filename, "rb"));
-    if (!fh || !read_entire_file(fh.get(), 1 << 20, filedata)) {
+    if (!fh) {
         fl_message_title(_("Error"));
         fl_alert("%s", _("Could not read the bank file."));
         return;
     }
-    fh.reset();
 
     if (format == -1) {
         const char *ext = fl_filename_ext(filename);
@@ -158,214 +181,364 @@ void Main_Component::load_bank_file(const char *filename, int format)
             format = Bank_Format::RealMajor;
         else if (!strcmp(ext, ".syx"))
             format = Bank_Format::SystemExclusive;
+        else if (!strcmp(ext, ".fmlib"))
+            format = Bank_Format::Library;
+        else if (!strcmp(ext, ".mid") || !strcmp(ext, ".midi"))
+            format = Bank_Format::StandardMidiFile;
     }
 
-    bool loaded = false;
-    switch (format) {
-    case Bank_Format::RealMajor:
-        loaded = Patch_Loader::load_realmajor_bank(filedata.data(), filedata.size(), *pbank_);
-        break;
-    case Bank_Format::SystemExclusive:
-        loaded = Patch_Loader::load_sysex_bank(filedata.data(), filedata.size(), *pbank_);
-        break;
+    std::unique_ptr<Patch_Bank> pbank_tmp(new Patch_Bank);
+    size_t count = 0;
+
+    auto on_patch = [&pbank_tmp, &count](const Patch &pat) -> bool {
+                        unsigned patchno = pat.patch_number();
+                        count += !pbank_tmp->used[patchno];
+                        pbank_tmp->slot[patchno] = pat;
+                        pbank_tmp->used[patchno] = true;
+                        return true;
+                    };
+
+    if (format == Bank_Format::Library) {
+        Patch_Archive archive;
+        if (!archive.open(fh.get())) {
+            fl_message_title(_("Error"));
+            fl_alert("%s", _("Could not read the bank file."));
+            return;
+        }
+        // the slot of the entry places the patch, not its own number
+        for (size_t i = 0, n = archive.size(); i < n; ++i) {
+            unsigned slot = archive.entry(i).slot;
+            if (slot < Patch_Bank::max_count) {
+                Patch pat = archive.patch(i);
+                pat.patch_number(slot);
+                on_patch(pat);
+            }
+        }
+    }
+    else if (!Patch_Stream_Loader::load_file(fh.get(), format, on_patch)) {
+        fl_message_title(_("Error"));
+        fl_alert("%s", _("Could not read the bank file."));
+        return;
     }
+    fh.reset();
 
-    if (!loaded) {
+    if (count == 0) {
         fl_message_title(_("Error"));
         fl_alert("%s", _("Could not load the bank file."));
         return;
     }
 
+    *pbank_ = *pbank_tmp;
+
     for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
         if (pbank_->used[i])
             pbank_->slot[i].patch_number(i);
     }
+    bank_file_->assign(filename, format, *pbank_);
+    journal_->rebase(*pbank_, false);
 
     refresh_bank_browser();
     refresh_patch_display();
 }
 
+bool Main_Component::recover_journal()
+{
+    bool recovered = false;
+
+    std::unique_ptr<Patch_Bank> pbank(new Patch_Bank);
+    if (Edit_Journal::recover(journal_->filename(), *pbank)) {
+        fl_message_title(_("Recover"));
+        if (fl_choice("%s", _("No"), _("Yes"), nullptr, _("The last session ended with unsaved edits. Recover them?")) == 1) {
+            *pbank_ = *pbank;
+            bank_file_->reset(*pbank_);
+            refresh_bank_browser();
+            refresh_patch_display();
+            recovered = true;
+        }
+    }
+
+    // from now on, the edits of this session are journaled
+    journal_->rebase(*pbank_, recovered);
+    return recovered;
+}
+
 void Main_Component::refresh_bank_browser()
 {
-    Fl_Browser &br = *br_bank;
+    Patch_Browser &br = *br_bank;
     Patch_Bank &pbank = *pbank_;
 
     br.clear();
     for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
         if (pbank.used[i]) {
-            std::string text = std::to_string(i + 1) + " - " + pbank.slot[i].name();
-            br.add(text.c_str(), (void *)(uintptr_t)i);
+            char text[64];
+            format_bank_row(text, sizeof(text), i, pbank.slot[i]);
+            br.add(i, text);
         }
     }
 }
 
-void Main_Component::refresh_patch_display()
+void Main_Component::refresh_bank_browser_row(unsigned nth)
+{
+    Patch_Browser &br = *br_bank;
+    Patch_Bank &pbank = *pbank_;
+
+    // the browser keeps its selection across the change
+    if (!pbank.used[nth]) {
+        br.remove(nth);
+        return;
+    }
+
+    char text[64];
+    format_bank_row(text, sizeof(text), nth, pbank.slot[nth]);
+    br.add(nth, text);
+}
+
+void Main_Component::refresh_patch_display(int regions)
 {
     unsigned patchno = get_patch_number();
     if (patchno == ~0u)
         return;
     const Patch &pat = pbank_->slot[patchno];
 
-    txt_patch_name->value(pat.name().c_str());
-
     P_General &pgen = *pgen_;
-    chk_compressor->value(pgen.enable_compressor().get(pat));
-    chk_filter->value(pgen.enable_filter().get(pat));
-    chk_pitch->value(pgen.enable_pitch().get(pat));
-    chk_chorus->value(pgen.enable_modulator().get(pat));
-    chk_delay->value(pgen.enable_delay().get(pat));
-    chk_reverb->value(pgen.enable_reverb().get(pat));
-    chk_equalizer->value(pgen.enable_equalizer().get(pat));
-    chk_noise_gate->value(pgen.enable_noisegate().get(pat));
-
-    assoc_.clear();
-    assoc_entered_.clear();
-
-    Association *a;
-
-    a = setup_slider(sl_tap_tempo, pgen.tap_tempo());
-    a->value_labels.push_back(lbl_tap_tempo);
-
-    setup_checkbox(chk_relay1, pgen.relay1());
-    setup_checkbox(chk_relay2, pgen.relay2());
-    setup_choice(cb_routing, pgen.routing());
-
-    a = setup_slider(sl_out_level, pgen.out_level());
-    a->value_labels.push_back(lbl_out_level);
-
-    setup_checkbox(chk_compressor, pgen.enable_compressor(), Assoc_Refresh_Full);
-    setup_checkbox(chk_filter, pgen.enable_filter(), Assoc_Refresh_Full);
-    setup_checkbox(chk_pitch, pgen.enable_pitch(), Assoc_Refresh_Full);
-    setup_checkbox(chk_chorus, pgen.enable_modulator(), Assoc_Refresh_Full);
-    setup_checkbox(chk_delay, pgen.enable_delay(), Assoc_Refresh_Full);
-    setup_checkbox(chk_reverb, pgen.enable_reverb(), Assoc_Refresh_Full);
-    setup_checkbox(chk_equalizer, pgen.enable_equalizer(), Assoc_Refresh_Full);
-    setup_checkbox(chk_noise_gate, pgen.enable_noisegate(), Assoc_Refresh_Full);
-
-    setup_choice(cb_filter, pgen.type_filter(), Assoc_Refresh_Full);
-    setup_choice(cb_pitch, pgen.type_pitch(), Assoc_Refresh_Full);
-    setup_choice(cb_chorus, pgen.type_modulation(), Assoc_Refresh_Full);
-    setup_choice(cb_delay, pgen.type_delay(), Assoc_Refresh_Full);
-    setup_choice(cb_reverb, pgen.type_reverb(), Assoc_Refresh_Full);
-
-    std::array<Fl_Group_Ex *, 6> box_cpr
-        {{ box_cpr1, box_cpr2, box_cpr3, box_cpr4, box_cpr5, box_cpr6 }};
-    setup_boxes(pgen.enable_compressor().get(pat), pgen.compressor, box_cpr.data(), box_cpr.size());
-
-    std::array<Fl_Group_Ex *, 9> box_eq
-        {{ box_eq1, box_eq2, box_eq3, box_eq4, box_eq5, box_eq6, box_eq7, box_eq8, box_eq9 }};
-    setup_boxes(pgen.enable_equalizer().get(pat), pgen.equalizer, box_eq.data(), box_eq.size());
-
-    std::array<Fl_Group_Ex *, 6> box_ng
-        {{ box_ng1, box_ng2, box_ng3, box_ng4, box_ng5, box_ng6 }};
-    setup_boxes(pgen.enable_noisegate().get(pat), pgen.noise_gate, box_ng.data(), box_ng.size());
-
-    std::array<Fl_Group_Ex *, 14> box_rev
-        {{ box_rev1, box_rev2, box_rev3, box_rev4, box_rev5, box_rev6, box_rev7, box_rev8, box_rev9, box_rev10, box_rev11, box_rev12, box_rev13, box_rev14 }};
-    setup_boxes(pgen.enable_reverb().get(pat), pgen.reverb, box_rev.data(), box_rev.size());
-
-    std::array<Fl_Group_Ex *, 14> box_pit
-        {{ box_pit1, box_pit2, box_pit3, box_pit4, box_pit5, box_pit6, box_pit7, box_pit8, box_pit9, box_pit10, box_pit11, box_pit12, box_pit13, box_pit14 }};
-    setup_boxes(pgen.enable_pitch().get(pat), pgen.pitch->dispatch(pat), box_pit.data(), box_pit.size());
-
-    std::array<Fl_Group_Ex *, 14> box_del
-        {{ box_del1, box_del2, box_del3, box_del4, box_del5, box_del6, box_del7, box_del8, box_del9, box_del10, box_del11, box_del12, box_del13, box_del14 }};
-    setup_boxes(pgen.enable_delay().get(pat), pgen.delay->dispatch(pat), box_del.data(), box_del.size());
-
-    std::array<Fl_Group_Ex *, 14> box_flt
-        {{ box_flt1, box_flt2, box_flt3, box_flt4, box_flt5, box_flt6, box_flt7, box_flt8, box_flt9, box_flt10, box_flt11, box_flt12, box_flt13, box_flt14 }};
-    setup_boxes(pgen.enable_filter().get(pat), pgen.filter->dispatch(pat), box_flt.data(), box_flt.size());
-
-    std::array<Fl_Group_Ex *, 14> box_cho
-        {{ box_cho1, box_cho2, box_cho3, box_cho4, box_cho5, box_cho6, box_cho7, box_cho8, box_cho9, box_cho10, box_cho11, box_cho12, box_cho13, box_cho14 }};
-    setup_boxes(pgen.enable_modulator().get(pat), pgen.modulation->dispatch(pat), box_cho.data(), box_cho.size());
-
-    setup_modifier_row(_("Filter"), pgen.enable_filter().get(pat), 0, pgen.filter->dispatch(pat));
-    setup_modifier_row(_("Pitch"), pgen.enable_pitch().get(pat), 1, pgen.pitch->dispatch(pat));
-    setup_modifier_row(_("Chorus/Flanger"), pgen.enable_modulator().get(pat), 2, pgen.modulation->dispatch(pat));
-    setup_modifier_row(_("Delay"), pgen.enable_delay().get(pat), 3, pgen.delay->dispatch(pat));
-    setup_modifier_row(_("Reverb"), pgen.enable_reverb().get(pat), 4, pgen.reverb);
-
-    for (const auto &a : assoc_) {
+
+    // the rows of the modifiers window wait until it is visible
+    int deferred = 0;
+    if (!win_modifiers_ || !win_modifiers_->shown()) {
+        deferred = regions & Region_Modifiers;
+        stale_modifiers_ |= deferred;
+    }
+
+    if (regions & Region_General) {
+        txt_patch_name->value(pat.name().c_str());
+
+        chk_compressor->value(pgen.enable_compressor().get(pat));
+        chk_filter->value(pgen.enable_filter().get(pat));
+        chk_pitch->value(pgen.enable_pitch().get(pat));
+        chk_chorus->value(pgen.enable_modulator().get(pat));
+        chk_delay->value(pgen.enable_delay().get(pat));
+        chk_reverb->value(pgen.enable_reverb().get(pat));
+        chk_equalizer->value(pgen.enable_equalizer().get(pat));
+        chk_noise_gate->value(pgen.enable_noisegate().get(pat));
+    }
+
+    // the controls are kept, and those of the regions are reconfigured
+    for (Association *a : assoc_) {
+        if (a->region & regions)
+            a->active = false;
+    }
+    assoc_.erase(std::remove_if(assoc_.begin(), assoc_.end(),
+                                [](const Association *a) -> bool { return !a->active; }),
+                 assoc_.end());
+    assoc_entered_.remove_if([](const Association *a) -> bool { return !a->active; });
+    size_t first_assoc = assoc_.size();
+    regions &= ~deferred;
+
+    if (regions & Region_General) {
+        Association *a;
+
+        a = setup_slider(sl_tap_tempo, pgen.tap_tempo());
+        a->value_labels.push_back(lbl_tap_tempo);
+
+        setup_checkbox(chk_relay1, pgen.relay1());
+        setup_checkbox(chk_relay2, pgen.relay2());
+        setup_choice(cb_routing, pgen.routing(), Region_Matrix);
+
+        a = setup_slider(sl_out_level, pgen.out_level());
+        a->value_labels.push_back(lbl_out_level);
+
+        setup_checkbox(chk_compressor, pgen.enable_compressor(), Region_Compressor);
+        setup_checkbox(chk_filter, pgen.enable_filter(), Region_Filter|Region_Modifiers_Filter);
+        setup_checkbox(chk_pitch, pgen.enable_pitch(), Region_Pitch|Region_Modifiers_Pitch);
+        setup_checkbox(chk_chorus, pgen.enable_modulator(), Region_Modulation|Region_Modifiers_Modulation);
+        setup_checkbox(chk_delay, pgen.enable_delay(), Region_Delay|Region_Modifiers_Delay);
+        setup_checkbox(chk_reverb, pgen.enable_reverb(), Region_Reverb|Region_Modifiers_Reverb);
+        setup_checkbox(chk_equalizer, pgen.enable_equalizer(), Region_Equalizer|Region_Eq_Curve);
+        setup_checkbox(chk_noise_gate, pgen.enable_noisegate(), Region_Noise_Gate);
+
+        setup_choice(cb_filter, pgen.type_filter(), Region_Filter|Region_Modifiers_Filter);
+        setup_choice(cb_pitch, pgen.type_pitch(), Region_Pitch|Region_Modifiers_Pitch);
+        setup_choice(cb_chorus, pgen.type_modulation(), Region_Modulation|Region_Modifiers_Modulation);
+        setup_choice(cb_delay, pgen.type_delay(), Region_Delay|Region_Modifiers_Delay);
+        setup_choice(cb_reverb, pgen.type_reverb(), Region_Reverb|Region_Modifiers_Reverb);
+    }
+
+    if (regions & Region_Compressor) {
+        std::array<Fl_Group_Ex *, 6> box_cpr
+            {{ box_cpr1, box_cpr2, box_cpr3, box_cpr4, box_cpr5, box_cpr6 }};
+        setup_boxes(pgen.enable_compressor().get(pat), pgen.compressor, box_cpr.data(), box_cpr.size(), Region_Compressor);
+    }
+
+    if (regions & Region_Equalizer) {
+        std::array<Fl_Group_Ex *, 9> box_eq
+            {{ box_eq1, box_eq2, box_eq3, box_eq4, box_eq5, box_eq6, box_eq7, box_eq8, box_eq9 }};
+        setup_boxes(pgen.enable_equalizer().get(pat), pgen.equalizer, box_eq.data(), box_eq.size(), Region_Equalizer, Region_Eq_Curve);
+    }
+
+    if (regions & Region_Noise_Gate) {
+        std::array<Fl_Group_Ex *, 6> box_ng
+            {{ box_ng1, box_ng2, box_ng3, box_ng4, box_ng5, box_ng6 }};
+        setup_boxes(pgen.enable_noisegate().get(pat), pgen.noise_gate, box_ng.data(), box_ng.size(), Region_Noise_Gate);
+    }
+
+    if (regions & Region_Reverb) {
+        std::array<Fl_Group_Ex *, 14> box_rev
+            {{ box_rev1, box_rev2, box_rev3, box_rev4, box_rev5, box_rev6, box_rev7, box_rev8, box_rev9, box_rev10, box_rev11, box_rev12, box_rev13, box_rev14 }};
+        setup_boxes(pgen.enable_reverb().get(pat), pgen.reverb, box_rev.data(), box_rev.size(), Region_Reverb);
+    }
+
+    if (regions & Region_Pitch) {
+        std::array<Fl_Group_Ex *, 14> box_pit
+            {{ box_pit1, box_pit2, box_pit3, box_pit4, box_pit5, box_pit6, box_pit7, box_pit8, box_pit9, box_pit10, box_pit11, box_pit12, box_pit13, box_pit14 }};
+        setup_boxes(pgen.enable_pitch().get(pat), pgen.pitch->dispatch(pat), box_pit.data(), box_pit.size(), Region_Pitch);
+    }
+
+    if (regions & Region_Delay) {
+        std::array<Fl_Group_Ex *, 14> box_del
+            {{ box_del1, box_del2, box_del3, box_del4, box_del5, box_del6, box_del7, box_del8, box_del9, box_del10, box_del11, box_del12, box_del13, box_del14 }};
+        setup_boxes(pgen.enable_delay().get(pat), pgen.delay->dispatch(pat), box_del.data(), box_del.size(), Region_Delay);
+    }
+
+    if (regions & Region_Filter) {
+        std::array<Fl_Group_Ex *, 14> box_flt
+            {{ box_flt1, box_flt2, box_flt3, box_flt4, box_flt5, box_flt6, box_flt7, box_flt8, box_flt9, box_flt10, box_flt11, box_flt12, box_flt13, box_flt14 }};
+        setup_boxes(pgen.enable_filter().get(pat), pgen.filter->dispatch(pat), box_flt.data(), box_flt.size(), Region_Filter);
+    }
+
+    if (regions & Region_Modulation) {
+        std::array<Fl_Group_Ex *, 14> box_cho
+            {{ box_cho1, box_cho2, box_cho3, box_cho4, box_cho5, box_cho6, box_cho7, box_cho8, box_cho9, box_cho10, box_cho11, box_cho12, box_cho13, box_cho14 }};
+        setup_boxes(pgen.enable_modulator().get(pat), pgen.modulation->dispatch(pat), box_cho.data(), box_cho.size(), Region_Modulation);
+    }
+
+    if (regions & Region_Modifiers_Filter)
+        setup_modifier_row(_("Filter"), pgen.enable_filter().get(pat), 0, pgen.filter->dispatch(pat), Region_Modifiers_Filter);
+    if (regions & Region_Modifiers_Pitch)
+        setup_modifier_row(_("Pitch"), pgen.enable_pitch().get(pat), 1, pgen.pitch->dispatch(pat), Region_Modifiers_Pitch);
+    if (regions & Region_Modifiers_Modulation)
+        setup_modifier_row(_("Chorus/Flanger"), pgen.enable_modulator().get(pat), 2, pgen.modulation->dispatch(pat), Region_Modifiers_Modulation);
+    if (regions & Region_Modifiers_Delay)
+        setup_modifier_row(_("Delay"), pgen.enable_delay().get(pat), 3, pgen.delay->dispatch(pat), Region_Modifiers_Delay);
+    if (regions & Region_Modifiers_Reverb)
+        setup_modifier_row(_("Reverb"), pgen.enable_reverb().get(pat), 4, pgen.reverb, Region_Modifiers_Reverb);
+    stale_modifiers_ &= ~regions;
+
+    for (size_t i = first_assoc, n = assoc_.size(); i < n; ++i) {
+        Association *a = assoc_[i];
         if (Fl_Widget *w = a->value_widget)
             w->callback(&on_edited_parameter, this);
         a->update_value(pat);
     }
 
-    update_eq_display();
-    update_matrix_display();
+    if (regions & Region_Eq_Curve)
+        update_eq_display();
+    if (regions & Region_Matrix)
+        update_matrix_display();
+}
+
+Association *Main_Component::pooled_association(Fl_Widget *w)
+{
+    Association *&a = assoc_index_[w];
+    if (!a) {
+        assoc_pool_.emplace_back(new Association);
+        a = assoc_pool_.back().get();
+    }
+    return a;
+}
+
+Association *Main_Component::find_association(Fl_Widget *w) const
+{
+    auto it = assoc_index_.find(w);
+    if (it == assoc_index_.end() || !it->second->active)
+        return nullptr;
+    return it->second;
 }
 
-Association *Main_Component::setup_slider(Fl_Slider_Ex *sl, Parameter_Access &p, int flags)
+Association *Main_Component::setup_slider(Fl_Slider_Ex *sl, Parameter_Access &p, int dependents)
 {
-    std::unique_ptr<Association> a(new Association);
+    Association *a = pooled_association(sl);
     a->access = &p;
     a->value_widget = sl;
     a->kind = Assoc_Slider;
-    a->flags |= flags;
+    a->region = Region_General;
+    a->dependents = dependents;
+    a->active = true;
+    a->value_labels.clear();
 
     sl->range(p.min(), p.max());
     sl->step(1);
     sl->enter_callback(&on_enter_parameter_control, this);
     sl->leave_callback(&on_leave_parameter_control, this);
 
-    assoc_.emplace_back(a.get());
-    return a.release();
+    assoc_.push_back(a);
+    return a;
 }
 
-void Main_Component::setup_checkbox(Fl_Check_Button_Ex *chk, Parameter_Access &p, int flags)
+void Main_Component::setup_checkbox(Fl_Check_Button_Ex *chk, Parameter_Access &p, int dependents)
 {
-    std::unique_ptr<Association> a(new Association);
+    Association *a = pooled_association(chk);
     a->access = &p;
     a->value_widget = chk;
     a->kind = Assoc_Check;
-    a->flags |= flags;
+    a->region = Region_General;
+    a->dependents = dependents;
+    a->active = true;
 
     chk->enter_callback(&on_enter_parameter_control, this);
     chk->leave_callback(&on_leave_parameter_control, this);
 
-    assoc_.push_back(std::move(a));
+    assoc_.push_back(a);
 }
 
-void Main_Component::setup_choice(Fl_Choice_Ex *cb, Parameter_Access &p, int flags)
+void Main_Component::setup_choice(Fl_Choice_Ex *cb, Parameter_Access &p, int dependents)
 {
-    std::unique_ptr<Association> a(new Association);
+    Association *a = pooled_association(cb);
 
-    cb->clear();
+    // the entries are rebuilt only if the parameter changes
+    if (a->access != &p) {
+        cb->clear();
 
-    if (p.type() == PT_Choice) {
-        for (const std::string &value : static_cast<PA_Choice &>(p).values)
-            cb->add(value.c_str(), 0, nullptr);
-    }
-    else {
-        for (int i1 = p.min(), i2 = p.max(); i1 <= i2; ++i1)
-            cb->add(p.to_string(i1).c_str(), 0, nullptr);
+        if (p.type() == PT_Choice) {
+            for (const std::string &value : static_cast<PA_Choice &>(p).values)
+                cb->add(value.c_str(), 0, nullptr);
+        }
+        else {
+            for (int i1 = p.min(), i2 = p.max(); i1 <= i2; ++i1)
+                cb->add(p.to_string(i1).c_str(), 0, nullptr);
+        }
     }
 
     a->access = &p;
     a->value_widget = cb;
     a->kind = Assoc_Choice;
-    a->flags |= flags;
+    a->region = Region_General;
+    a->dependents = dependents;
+    a->active = true;
 
     cb->enter_callback(&on_enter_parameter_control, this);
     cb->leave_callback(&on_leave_parameter_control, this);
 
-    assoc_.push_back(std::move(a));
+    assoc_.push_back(a);
 }
 
-void Main_Component::setup_boxes(bool enable, const Parameter_Collection &pc, Fl_Group_Ex *boxes[], unsigned nboxes)
+void Main_Component::setup_boxes(bool enable, const Parameter_Collection &pc, Fl_Group_Ex *boxes[], unsigned nboxes, int region, int dependents)
 {
+    // each box has a dial from its first use, which is hidden when unused
     for (unsigned i = 0; i < nboxes; ++i) {
         Fl_Group_Ex *box = boxes[i];
-        box->clear();
         box->labeltype(FL_NO_LABEL);
+        auto it = assoc_index_.find(box);
+        if (it != assoc_index_.end())
+            it->second->value_widget->hide();
     }
     if (enable) {
         size_t slot_count = pc.slots.size();
         Fl_Group_Ex **box_frontp = boxes;
         Fl_Group_Ex **box_backp = boxes + nboxes;
 
-        std::unique_ptr<Fl_Group_Ex *[]> box_alloc(new Fl_Group_Ex *[nboxes]); 
+        enum { max_boxes = 16 };
+        assert(nboxes <= max_boxes);
+        Fl_Group_Ex *box_alloc[max_boxes];
         for (size_t i = 0; i < slot_count; ++i) {
             Parameter_Access *p = pc.slots[i].get();
             if (p->position == PP_Front)
@@ -378,43 +551,52 @@ void Main_Component::setup_boxes(bool enable, const Parameter_Collection &pc, Fl
         }
 
         for (size_t i = 0; i < slot_count; ++i) {
-            std::unique_ptr<Association> a(new Association);
-
             Parameter_Access *pa = pc.slots[i].get();
-            a->access = pa;
-
             Fl_Group_Ex *box = box_alloc[i];
-            a->group_box = box;
-            a->name_labels.push_back(box);
-            int bx = box->x(), by = box->y(), bw = box->w(), bh = box->h();
+            Association *a = pooled_association(box);
 
-            int padding = 16;
-            int wx = bx + padding, wy = by + padding;
-            int ww = bw - 2 * padding, wh = bh - 2 * padding;
+            if (!a->value_widget) {
+                int bx = box->x(), by = box->y(), bw = box->w(), bh = box->h();
 
-            box->labeltype(FL_NORMAL_LABEL);
-            box->labelsize(9);
-            box->align(FL_ALIGN_TOP|FL_ALIGN_INSIDE);
+                int padding = 16;
+                int wx = bx + padding, wy = by + padding;
+                int ww = bw - 2 * padding, wh = bh - 2 * padding;
 
-            box->begin();
-            Fl_Dial_Ex *dial = new Fl_Dial_Ex(wx, wy, ww, wh);
-            a->value_widget = dial;
-            a->kind = Assoc_Dial;
-            dial->range(pa->min(), pa->max());
-            dial->labeltype(FL_NORMAL_LABEL);
-            dial->labelsize(9);
-            dial->align(FL_ALIGN_BOTTOM);
-            dial->step(1);
-            box->end();
+                box->labelsize(9);
+                box->align(FL_ALIGN_TOP|FL_ALIGN_INSIDE);
 
-            a->value_labels.push_back(dial);
+                box->begin();
+                Fl_Dial_Ex *dial = new Fl_Dial_Ex(wx, wy, ww, wh);
+                dial->labeltype(FL_NORMAL_LABEL);
+                dial->labelsize(9);
+                dial->align(FL_ALIGN_BOTTOM);
+                dial->step(1);
+                box->end();
 
-            box->enter_callback(&on_enter_parameter_control, this);
-            box->leave_callback(&on_leave_parameter_control, this);
-            dial->enter_callback(&on_enter_parameter_control, this);
-            dial->leave_callback(&on_leave_parameter_control, this);
+                a->group_box = box;
+                a->value_widget = dial;
+                a->kind = Assoc_Dial;
+                a->name_labels.push_back(box);
+                a->value_labels.push_back(dial);
+                assoc_index_[dial] = a;
+
+                box->enter_callback(&on_enter_parameter_control, this);
+                box->leave_callback(&on_leave_parameter_control, this);
+                dial->enter_callback(&on_enter_parameter_control, this);
+                dial->leave_callback(&on_leave_parameter_control, this);
+            }
+
+            a->access = pa;
+            a->region = region;
+            a->dependents = dependents;
+            a->active = true;
 
-            assoc_.push_back(std::move(a));
+            Fl_Dial_Ex *dial = static_cast<Fl_Dial_Ex *>(a->value_widget);
+            dial->range(pa->min(), pa->max());
+            dial->show();
+            box->labeltype(FL_NORMAL_LABEL);
+
+            assoc_.push_back(a);
         }
     }
     for (unsigned i = 0; i < nboxes; ++i) {
@@ -423,14 +605,17 @@ void Main_Component::setup_boxes(bool enable, const Parameter_Collection &pc, Fl
     }
 }
 
-void Main_Component::setup_modifier_row(const char *title, bool enable, int row, Parameter_Collection &pc)
+void Main_Component::setup_modifier_row(const char *title, bool enable, int row, Parameter_Collection &pc, int region)
 {
     Modifiers_Editor *edt = edt_modifiers_;
 
+    // each box has an editor from its first use, which is hidden when unused
     for (unsigned i = 0, n = edt->columns; i < n; ++i) {
         Fl_Group *box = edt->box_from_coords(row, i);
         box->label("");
-        box->clear();
+        auto it = mod_editors_.find(box);
+        if (it != mod_editors_.end())
+            it->second->hide();
     }
 
     edt->label_for_row(row)->copy_label(title);
@@ -444,7 +629,9 @@ void Main_Component::setup_modifier_row(const char *title, bool enable, int row,
         }
 
         size_t slot_count = slots.size();
-        std::unique_ptr<Fl_Group *[]> box_alloc(new Fl_Group *[slot_count]); 
+        enum { max_boxes = Modifiers_Editor::columns };
+        assert(slot_count <= max_boxes);
+        Fl_Group *box_alloc[max_boxes];
         for (size_t i = 0, n = slot_count, c = 0; i < n; ++i) {
             Parameter_Access *p = slots[i];
             if (p->position == PP_Front)
@@ -461,12 +648,17 @@ void Main_Component::setup_modifier_row(const char *title, bool enable, int row,
             Parameter_Modifiers *pm = pa->modifiers.get();
 
             Fl_Group *box = box_alloc[i];
-            int bx = box->x(), by = box->y(), bw = box->w(), bh = box->h();
-
             box->label(pa->name);
-            box->begin();
-            Single_Mod_Editor *me = new Single_Mod_Editor(0, 0, bw, bh);
-            me->position(bx, by);
+
+            Single_Mod_Editor *&me = mod_editors_[box];
+            if (!me) {
+                int bx = box->x(), by = box->y(), bw = box->w(), bh = box->h();
+                box->begin();
+                me = new Single_Mod_Editor(0, 0, bw, bh);
+                me->position(bx, by);
+                box->end();
+            }
+            me->show();
 
             Fl_Slider *valuators[4] = {
                 me->sl_assignment, me->sl_min, me->sl_mid, me->sl_max
@@ -479,20 +671,21 @@ void Main_Component::setup_modifier_row(const char *title, bool enable, int row,
             };
 
             for (unsigned i = 0; i < 4; ++i) {
-                std::unique_ptr<Association> a(new Association);
                 Fl_Slider *sl = valuators[i];
                 Parameter_Access *pa = parameters[i];
                 sl->range(pa->max(), pa->min());
                 sl->step(1);
+                Association *a = pooled_association(sl);
                 a->access = pa;
                 a->group_box = box;
                 a->value_widget = sl;
                 a->kind = Assoc_Slider;
-                a->value_labels.push_back(value_labels[i]);
-                assoc_.push_back(std::move(a));
+                a->region = region;
+                a->dependents = 0;
+                a->active = true;
+                a->value_labels.assign(1, value_labels[i]);
+                assoc_.push_back(a);
             }
-
-            box->end();
         }
     }
 
@@ -602,36 +795,83 @@ void Main_Component::on_selected_patch()
 }
 
 void Main_Component::on_clicked_import()
+{
+    int x = btn_import->x();
+    int y = btn_import->y() + btn_import->h();
+
+    enum { Import_File, Import_Folder, Import_Folder_Unique, Import_Bank_Folder };
+    Fl_Menu_Item menu_list[] = {
+        Fl_Menu_Item{_("Patch file..."), 0, nullptr, (void *)(uintptr_t)Import_File},
+        Fl_Menu_Item{_("Folder..."), 0, nullptr, (void *)(uintptr_t)Import_Folder},
+        Fl_Menu_Item{_("Folder, skipping duplicates..."), 0, nullptr, (void *)(uintptr_t)Import_Folder_Unique, FL_MENU_DIVIDER},
+        Fl_Menu_Item{_("Bank from folder..."), 0, nullptr, (void *)(uintptr_t)Import_Bank_Folder},
+        Fl_Menu_Item{nullptr},
+    };
+
+    for (Fl_Menu_Item &item : menu_list)
+        item.labelsize(12);
+
+    const Fl_Menu_Item *choice = menu_list[0].popup(x, y);
+    if (!choice)
+        return;
+
+    switch ((uintptr_t)choice->user_data()) {
+    case Import_File:
+        import_patch_file();
+        break;
+    case Import_Folder:
+        import_patch_folder(false);
+        break;
+    case Import_Folder_Unique:
+        import_patch_folder(true);
+        break;
+    case Import_Bank_Folder:
+        import_bank_folder();
+        break;
+    }
+}
+
+void Main_Component::import_patch_file()
 {
     Fl_Native_File_Chooser f_chooser(Fl_Native_File_Chooser::BROWSE_FILE);
     f_chooser.title(_("Import..."));
     f_chooser.filter(_("Real Major patch\t*.realpatch\n"
-                       "Sysex patch\t*.syx"));
+                       "Sysex patch\t*.syx\n"
+                       "MIDI file\t*.mid"));
 
     if (f_chooser.show() != 0)
         return;
 
-    const char *filename = f_chooser.filename();
-    std::vector<uint8_t> filedata;
-    FILE_u fh(fl_fopen(filename, "rb"));
-    if (!fh || !read_entire_file(fh.get(), 1 << 20, filedata)) {
-        fl_message_title(_("Error"));
-        fl_alert("%s", _("Could not read the patch file."));
-        return;
-    }
-    fh.reset();
-
-    Patch pat;
-    bool loaded = false;
+    int format = -1;
     switch (f_chooser.filter_value()) {
     case 0:
-        loaded = Patch_Loader::load_realmajor_patch(filedata.data(), filedata.size(), pat);
+        format = Bank_Format::RealMajor;
         break;
     case 1:
-        loaded = Patch_Loader::load_sysex_patch(filedata.data(), filedata.size(), pat);
+        format = Bank_Format::SystemExclusive;
+        break;
+    case 2:
+        format = Bank_Format::StandardMidiFile;
         break;
     }
 
+    FILE_u fh(fl_fopen(f_chooser.filename(), "rb"));
+    Patch pat;
+    bool loaded = false;
+
+    auto on_patch = [&pat, &loaded](const Patch &p) -> bool {
+                        pat = p;
+                        loaded = true;
+                        return false;
+                    };
+
+    if (!fh || !Patch_Stream_Loader::load_file(fh.get(), format, on_patch)) {
+        fl_message_title(_("Error"));
+        fl_alert("%s", _("Could not read the patch file."));
+        return;
+    }
+    fh.reset();
+
     if (!loaded) {
         fl_message_title(_("Error"));
         fl_alert("%s", _("Could not load the patch file."));
@@ -646,7 +886,180 @@ void Main_Component::on_clicked_import()
     set_nth_patch(patchno, pat);
 }
 
+void Main_Component::import_patch_folder(bool skip_duplicates)
+{
+    Fl_Native_File_Chooser f_chooser(Fl_Native_File_Chooser::BROWSE_DIRECTORY);
+    f_chooser.title(_("Import folder..."));
+
+    if (f_chooser.show() != 0)
+        return;
+
+    std::vector<std::string> filenames;
+    if (!Patch_Directory::list_patch_files(f_chooser.filename(), filenames)) {
+        fl_message_title(_("Error"));
+        fl_alert("%s", _("Could not read the folder."));
+        return;
+    }
+
+    std::vector<Patch_Directory::Entry> entries;
+    auto progress = [this](size_t done, size_t total) {
+                        show_import_progress(done, total);
+                    };
+
+    deactivate();
+    Patch_Directory::load_patch_files(filenames, entries, progress);
+    activate();
+    reset_description_text();
+
+    // fill the free slots in the order of files
+    Patch_Bank &pbank = *pbank_;
+    unsigned first_patchno = ~0u;
+    size_t count_failed = 0;
+    size_t count_skipped = 0;
+    size_t count_duplicate = 0;
+
+    // on request, identify the patches which sound like one present already.
+    // the library stores them exactly, and the sounds are indexed over it.
+    Patch_Library lib;
+    Patch_Semantic_Hash identity;
+    std::unordered_multimap<uint64_t, Patch_Library::Id> sounds;
+    auto is_new_sound = [&lib, &identity, &sounds](const Patch &pat) -> bool {
+                            uint64_t hash = identity.hash(pat);
+                            auto range = sounds.equal_range(hash);
+                            for (auto it = range.first; it != range.second; ++it) {
+                                if (identity.equal(lib.get(it->second), pat))
+                                    return false;
+                            }
+                            sounds.emplace(hash, lib.insert(pat));
+                            return true;
+                        };
+
+    if (skip_duplicates) {
+        for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
+            if (pbank.used[i])
+                is_new_sound(pbank.slot[i]);
+        }
+    }
+
+    for (unsigned i = 0, patchno = 0, n = entries.size(); i < n; ++i) {
+        const Patch_Directory::Entry &ent = entries[i];
+        if (!ent.loaded) {
+            ++count_failed;
+            continue;
+        }
+        if (skip_duplicates && !is_new_sound(ent.patch)) {
+            ++count_duplicate;
+            continue;
+        }
+        while (patchno < Patch_Bank::max_count && pbank.used[patchno])
+            ++patchno;
+        if (patchno == Patch_Bank::max_count) {
+            ++count_skipped;
+            continue;
+        }
+        Patch before = pbank.slot[patchno];
+        pbank.slot[patchno] = ent.patch;
+        pbank.slot[patchno].patch_number(patchno);
+        pbank.used[patchno] = true;
+        edited_slot(patchno, before, false);
+        first_patchno = (first_patchno == ~0u) ? patchno : first_patchno;
+    }
+
+    if (first_patchno != ~0u) {
+        refresh_bank_browser();
+        set_patch_number(first_patchno);
+    }
+
+    unsigned count_imported = (unsigned)(entries.size() - count_failed - count_skipped - count_duplicate);
+    if (skip_duplicates) {
+        fl_message_title(_("Import folder"));
+        fl_message(_("Imported files: %u\n"
+                     "Files which could not be loaded: %u\n"
+                     "Files which did not fit in the bank: %u\n"
+                     "Files with the sound of another patch: %u"),
+                   count_imported, (unsigned)count_failed,
+                   (unsigned)count_skipped, (unsigned)count_duplicate);
+    }
+    else if (count_failed > 0 || count_skipped > 0 || first_patchno == ~0u) {
+        fl_message_title(_("Import folder"));
+        fl_message(_("Imported files: %u\n"
+                     "Files which could not be loaded: %u\n"
+                     "Files which did not fit in the bank: %u"),
+                   count_imported, (unsigned)count_failed, (unsigned)count_skipped);
+    }
+}
+
+void Main_Component::import_bank_folder()
+{
+    Fl_Native_File_Chooser f_chooser(Fl_Native_File_Chooser::BROWSE_DIRECTORY);
+    f_chooser.title(_("Import bank from folder..."));
+
+    if (f_chooser.show() != 0)
+        return;
+
+    auto progress = [this](size_t done, size_t total) {
+                        show_import_progress(done, total);
+                    };
+
+    deactivate();
+    bool loaded = Patch_Directory::load_bank(f_chooser.filename(), *pbank_, progress);
+    activate();
+    reset_description_text();
+
+    if (!loaded) {
+        fl_message_title(_("Error"));
+        fl_alert("%s", _("Could not load a bank from the folder."));
+        return;
+    }
+    bank_file_->reset(*pbank_);
+    journal_->rebase(*pbank_, true);
+
+    refresh_bank_browser();
+    set_patch_number(0);
+}
+
+void Main_Component::show_import_progress(size_t done, size_t total)
+{
+    std::string text = _("Importing patch files...");
+    text += "\n" + std::to_string(done) + " / " + std::to_string(total);
+    txt_description->copy_label(text.c_str());
+    Fl::check();
+}
+
 void Main_Component::on_clicked_export()
+{
+    int x = btn_export->x();
+    int y = btn_export->y() + btn_export->h();
+
+    enum { Export_File, Export_Bank_RealMajor, Export_Bank_Sysex };
+    Fl_Menu_Item menu_list[] = {
+        Fl_Menu_Item{_("Patch file..."), 0, nullptr, (void *)(uintptr_t)Export_File, FL_MENU_DIVIDER},
+        Fl_Menu_Item{_("Bank to folder as Real Major patches..."), 0, nullptr, (void *)(uintptr_t)Export_Bank_RealMajor},
+        Fl_Menu_Item{_("Bank to folder as sysex patches..."), 0, nullptr, (void *)(uintptr_t)Export_Bank_Sysex},
+        Fl_Menu_Item{nullptr},
+    };
+
+    for (Fl_Menu_Item &item : menu_list)
+        item.labelsize(12);
+
+    const Fl_Menu_Item *choice = menu_list[0].popup(x, y);
+    if (!choice)
+        return;
+
+    switch ((uintptr_t)choice->user_data()) {
+    case Export_File:
+        export_patch_file();
+        break;
+    case Export_Bank_RealMajor:
+        export_bank_folder(Bank_Format::RealMajor);
+        break;
+    case Export_Bank_Sysex:
+        export_bank_folder(Bank_Format::SystemExclusive);
+        break;
+    }
+}
+
+void Main_Component::export_patch_file()
 {
     unsigned patchno = get_patch_number();
     if (patchno == ~0u)
@@ -656,7 +1069,8 @@ void Main_Component::on_clicked_export()
     Fl_Native_File_Chooser chooser(Fl_Native_File_Chooser::BROWSE_SAVE_FILE);
     chooser.title(_("Export..."));
     chooser.filter(_("Real Major patch\t*.realpatch\n"
-                     "Sysex patch\t*.syx"));
+                     "Sysex patch\t*.syx\n"
+                     "MIDI file\t*.mid"));
 
     if (chooser.show() != 0)
         return;
@@ -674,6 +1088,11 @@ void Main_Component::on_clicked_export()
         if (file_name_extension(filename).empty())
             filename += ".syx";
         break;
+    case 2:
+        Patch_Writer::save_midifile_patch(pat, data);
+        if (file_name_extension(filename).empty())
+            filename += ".mid";
+        break;
     }
 
     if (fl_access(filename.c_str(), 0) == 0) {
@@ -691,6 +1110,50 @@ void Main_Component::on_clicked_export()
     }
 }
 
+void Main_Component::export_bank_folder(int format)
+{
+    Fl_Native_File_Chooser chooser(Fl_Native_File_Chooser::BROWSE_DIRECTORY);
+    chooser.title(_("Export bank to folder..."));
+
+    if (chooser.show() != 0)
+        return;
+
+    const Patch_Bank &pbank = *pbank_;
+    std::string dirname = chooser.filename();
+    if (!dirname.empty() && dirname.back() != '/')
+        dirname.push_back('/');
+
+    bool exists = false;
+    for (unsigned i = 0; i < Patch_Bank::max_count && !exists; ++i) {
+        if (pbank.used[i]) {
+            std::string filename = dirname + Patch_Directory::slot_file_name(pbank.slot[i], i, format);
+            exists = fl_access(filename.c_str(), 0) == 0;
+        }
+    }
+
+    if (exists) {
+        fl_message_title(_("Confirm overwrite"));
+        if (fl_choice("%s", _("No"), _("Yes"), nullptr, _("Some files already exist. Replace them?")) != 1)
+            return;
+    }
+
+    deactivate();
+    std::vector<std::string> failed;
+    bool saved = Patch_Directory::save_bank(dirname.c_str(), pbank, format, &failed);
+    activate();
+
+    if (!saved) {
+        std::string text = _("Could not save the patch files:");
+        for (size_t i = 0, n = std::min<size_t>(failed.size(), 10); i < n; ++i)
+            text += "\n" + failed[i];
+        if (failed.size() > 10)
+            text += "\n...";
+        fl_message_title(_("Error"));
+        fl_alert("%s", text.c_str());
+        return;
+    }
+}
+
 void Main_Component::on_clicked_change()
 {
     unsigned patchno = get_patch_number();
@@ -707,11 +1170,46 @@ void Main_Component::on_clicked_change()
 }
 
 void Main_Component::on_clicked_load()
+{
+    int x = btn_load->x();
+    int y = btn_load->y() + btn_load->h();
+
+    enum { Load_File, Load_Revision, Load_Factory };
+    Fl_Menu_Item menu_list[] = {
+        Fl_Menu_Item{_("Bank file..."), 0, nullptr, (void *)(uintptr_t)Load_File},
+        Fl_Menu_Item{_("Revision from history..."), 0, nullptr, (void *)(uintptr_t)Load_Revision, FL_MENU_DIVIDER},
+        Fl_Menu_Item{_("Factory bank"), 0, nullptr, (void *)(uintptr_t)Load_Factory},
+        Fl_Menu_Item{nullptr},
+    };
+
+    for (Fl_Menu_Item &item : menu_list)
+        item.labelsize(12);
+
+    const Fl_Menu_Item *choice = menu_list[0].popup(x, y);
+    if (!choice)
+        return;
+
+    switch ((uintptr_t)choice->user_data()) {
+    case Load_File:
+        load_bank_dialog();
+        break;
+    case Load_Revision:
+        load_bank_revision();
+        break;
+    case Load_Factory:
+        load_factory_bank();
+        break;
+    }
+}
+
+void Main_Component::load_bank_dialog()
 {
     Fl_Native_File_Chooser f_chooser(Fl_Native_File_Chooser::BROWSE_FILE);
     f_chooser.title(_("Load..."));
     f_chooser.filter(_("Real Major bank\t*.realmajor\n"
-                       "Sysex bank\t*.syx"));
+                       "Sysex bank\t*.syx\n"
+                       "Patch library\t*.fmlib\n"
+                       "MIDI file\t*.mid"));
 
     if (f_chooser.show() != 0)
         return;
@@ -724,34 +1222,158 @@ void Main_Component::on_clicked_load()
     case 1:
         format = Bank_Format::SystemExclusive;
         break;
+    case 2:
+        format = Bank_Format::Library;
+        break;
+    case 3:
+        format = Bank_Format::StandardMidiFile;
+        break;
     }
 
     return load_bank_file(f_chooser.filename(), format);
 }
 
+void Main_Component::load_bank_revision()
+{
+    Fl_Native_File_Chooser f_chooser(Fl_Native_File_Chooser::BROWSE_FILE);
+    f_chooser.title(_("Load revision of..."));
+    f_chooser.filter(_("Real Major bank\t*.realmajor\n"
+                       "Sysex bank\t*.syx\n"
+                       "Patch library\t*.fmlib\n"
+                       "MIDI file\t*.mid"));
+
+    if (f_chooser.show() != 0)
+        return;
+
+    Bank_History history;
+    if (!history.open(Bank_History::directory_for(f_chooser.filename()), false) ||
+        history.revision_count() == 0)
+    {
+        fl_message_title(_("Error"));
+        fl_alert("%s", _("This bank has no history."));
+        return;
+    }
+
+    // the most recent revisions first
+    enum { max_revisions_shown = 50 };
+    size_t count = std::min<size_t>(history.revision_count(), max_revisions_shown);
+    std::vector<std::string> labels(count);
+    std::vector<Fl_Menu_Item> menu_list;
+    menu_list.reserve(count + 1);
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t revision = history.revision_count() - 1 - i;
+        int64_t time = 0;
+        char time_text[64] = "?";
+        if (history.revision_time(revision, time)) {
+            time_t t = (time_t)time;
+            if (const struct tm *tm = localtime(&t))
+                strftime(time_text, sizeof(time_text), "%Y-%m-%d %H:%M:%S", tm);
+        }
+        labels[i] = std::to_string(revision + 1) + ": " + time_text;
+        menu_list.push_back(Fl_Menu_Item{labels[i].c_str(), 0, nullptr, (void *)(uintptr_t)revision});
+    }
+    menu_list.push_back(Fl_Menu_Item{nullptr});
+
+    for (Fl_Menu_Item &item : menu_list)
+        item.labelsize(12);
+
+    int x = btn_load->x();
+    int y = btn_load->y() + btn_load->h();
+    const Fl_Menu_Item *choice = menu_list[0].popup(x, y, _("Revision"));
+    if (!choice)
+        return;
+
+    if (!history.checkout((uintptr_t)choice->user_data(), *pbank_)) {
+        fl_message_title(_("Error"));
+        fl_alert("%s", _("Could not load the revision."));
+        return;
+    }
+    bank_file_->reset(*pbank_);
+    journal_->rebase(*pbank_, true);
+
+    refresh_bank_browser();
+    refresh_patch_display();
+}
+
+void Main_Component::load_factory_bank()
+{
+    fl_message_title(_("Confirm load"));
+    if (fl_choice("%s", _("No"), _("Yes"), nullptr, _("Replace the bank with the factory bank?")) != 1)
+        return;
+
+    Factory_Bank::load(*pbank_);
+    bank_file_->reset(*pbank_);
+    journal_->rebase(*pbank_, true);
+
+    refresh_bank_browser();
+    refresh_patch_display();
+}
+
 void Main_Component::on_clicked_save()
+{
+    int x = btn_save->x();
+    int y = btn_save->y() + btn_save->h();
+
+    enum { Save_File, Save_File_History };
+    Fl_Menu_Item menu_list[] = {
+        Fl_Menu_Item{_("Bank file..."), 0, nullptr, (void *)(uintptr_t)Save_File},
+        Fl_Menu_Item{_("Bank file, keeping its history..."), 0, nullptr, (void *)(uintptr_t)Save_File_History},
+        Fl_Menu_Item{nullptr},
+    };
+
+    for (Fl_Menu_Item &item : menu_list)
+        item.labelsize(12);
+
+    const Fl_Menu_Item *choice = menu_list[0].popup(x, y);
+    if (!choice)
+        return;
+
+    switch ((uintptr_t)choice->user_data()) {
+    case Save_File:
+        save_bank_dialog(false);
+        break;
+    case Save_File_History:
+        save_bank_dialog(true);
+        break;
+    }
+}
+
+void Main_Component::save_bank_dialog(bool start_history)
 {
     Fl_Native_File_Chooser chooser(Fl_Native_File_Chooser::BROWSE_SAVE_FILE);
     chooser.title(_("Save..."));
     chooser.filter(_("Real Major bank\t*.realmajor\n"
-                     "Sysex bank\t*.syx"));
+                     "Sysex bank\t*.syx\n"
+                     "Patch library\t*.fmlib\n"
+                     "MIDI file\t*.mid"));
 
     if (chooser.show() != 0)
         return;
 
     std::string filename = chooser.filename();
-    std::vector<uint8_t> data;
+    int format = -1;
     switch (chooser.filter_value()) {
     case 0:
-        Patch_Writer::save_realmajor_bank(*pbank_, data);
+        format = Bank_Format::RealMajor;
         if (file_name_extension(filename).empty())
             filename += ".realmajor";
         break;
     case 1:
-        Patch_Writer::save_sysex_bank(*pbank_, data);
+        format = Bank_Format::SystemExclusive;
         if (file_name_extension(filename).empty())
             filename += ".syx";
         break;
+    case 2:
+        format = Bank_Format::Library;
+        if (file_name_extension(filename).empty())
+            filename += ".fmlib";
+        break;
+    case 3:
+        format = Bank_Format::StandardMidiFile;
+        if (file_name_extension(filename).empty())
+            filename += ".mid";
+        break;
     }
 
     if (fl_access(filename.c_str(), 0) == 0) {
@@ -760,13 +1382,18 @@ void Main_Component::on_clicked_save()
             return;
     }
 
-    FILE_u fh(fl_fopen(filename.c_str(), "wb"));
-    if (fwrite(data.data(), 1, data.size(), fh.get()) != data.size()) {
-        fl_unlink(filename.c_str());
+    if (!bank_file_->save(filename, format, *pbank_)) {
         fl_message_title(_("Error"));
         fl_alert("%s", _("Could not save the bank file."));
         return;
     }
+    journal_->rebase(*pbank_, false);
+
+    // record a revision if the bank has a history, or start one on request.
+    // the save has succeeded already, so a failure here is not reported.
+    Bank_History history;
+    if (history.open(Bank_History::directory_for(filename), start_history))
+        history.commit(*pbank_, time(nullptr));
 }
 
 void Main_Component::on_clicked_new()
@@ -777,11 +1404,14 @@ void Main_Component::on_clicked_new()
         return;
 
     Patch_Bank &pbank = *pbank_;
+    Patch before = pbank.slot[patchno];
+    bool was_used = pbank.used[patchno];
     pbank.slot[patchno] = Patch::create_empty();
     pbank.slot[patchno].patch_number(patchno);
     pbank.used[patchno] = true;
+    edited_slot(patchno, before, was_used);
 
-    refresh_bank_browser();
+    refresh_bank_browser_row(patchno);
     set_patch_number(patchno);
 }
 
@@ -797,11 +1427,13 @@ void Main_Component::on_clicked_copy()
         return;
 
     Patch_Bank &pbank = *pbank_;
+    Patch before = pbank.slot[dst_patchno];
+    bool was_used = pbank.used[dst_patchno];
     pbank.slot[dst_patchno] = pbank.slot[src_patchno];
     pbank.used[dst_patchno] = true;
+    edited_slot(dst_patchno, before, was_used);
 
-    refresh_bank_browser();
-    set_patch_number(src_patchno);
+    refresh_bank_browser_row(dst_patchno);
 }
 
 void Main_Component::on_clicked_delete()
@@ -816,8 +1448,9 @@ void Main_Component::on_clicked_delete()
 
     Patch_Bank &pbank = *pbank_;
     pbank.used[patchno] = false;
+    edited_slot(patchno, pbank.slot[patchno], true);
 
-    refresh_bank_browser();
+    refresh_bank_browser_row(patchno);
     refresh_patch_display();
 }
 
@@ -830,6 +1463,8 @@ void Main_Component::on_clicked_receive()
         return;
 
     *pbank_ = pbank;
+    bank_file_->reset(*pbank_);
+    journal_->rebase(*pbank_, true);
     refresh_bank_browser();
     refresh_patch_display();
 }
@@ -859,8 +1494,26 @@ void Main_Component::on_clicked_send()
 
 void Main_Component::on_clicked_modifiers()
 {
+    if (!win_modifiers_)
+        create_modifiers_window();
+
     Fl_Double_Window &win = *win_modifiers_;
     win.show();
+
+    if (stale_modifiers_)
+        refresh_patch_display(stale_modifiers_);
+}
+
+void Main_Component::create_modifiers_window()
+{
+    Fl_Double_Window *win_modifiers = new Fl_Double_Window(810, 635);
+    win_modifiers_.reset(win_modifiers);
+    win_modifiers->label(_("Modifiers"));
+
+    win_modifiers->begin();
+    Modifiers_Editor *edt_modifiers = new Modifiers_Editor(0, 0, win_modifiers->w(), win_modifiers->h());
+    edt_modifiers_ = edt_modifiers;
+    win_modifiers->end();
 }
 
 void Main_Component::on_edited_patch_name()
@@ -870,9 +1523,10 @@ void Main_Component::on_edited_patch_name()
         return;
     Patch &pat = pbank_->slot[patchno];
 
+    Patch before = pat;
     pat.name(txt_patch_name->value());
-    refresh_bank_browser();
-    set_patch_number(patchno);
+    edited_slot(patchno, before, true);
+    refresh_bank_browser_row(patchno);
 
     if (chk_realtime->value())
         on_clicked_send();
@@ -887,28 +1541,20 @@ void Main_Component::on_edited_parameter(Fl_Widget *w, void *user_data)
         return;
 
     Patch &pat = self->pbank_->slot[patchno];
-    P_General &pgen = *self->pgen_;
-
-    Association *a = nullptr;
-    for (unsigned i = 0, n = self->assoc_.size(); i < n && !a; ++i) {
-        Association *cur = self->assoc_[i].get();
-        if (cur->value_widget == w)
-            a = cur;
-    }
 
+    Association *a = self->find_association(w);
     if (!a) {
         assert(false);
         return;
     }
 
+    Patch before = pat;
     a->update_from_widget(pat);
+    self->edited_slot(patchno, before, true);
 
-    if (a->flags & Assoc_Refresh_Full)
-        self->refresh_patch_display();
-    else if (pgen.equalizer.contains(*a->access))
-        self->update_eq_display();
-    else if (a->access == &pgen.routing())
-        self->update_matrix_display();
+    // rebuild what depends on the value only
+    if (a->dependents)
+        self->refresh_patch_display(a->dependents);
 
     if (self->chk_realtime->value())
         self->on_clicked_send();
@@ -918,15 +1564,7 @@ void Main_Component::on_enter_parameter_control(Fl_Widget *w, void *user_data)
 {
     Main_Component *self = (Main_Component *)user_data;
 
-    Association *a = nullptr;
-    for (unsigned i = 0, n = self->assoc_.size(); i < n && !a; ++i) {
-        Association *cur = self->assoc_[i].get();
-        if (cur->value_widget == w)
-            a = cur;
-        else if (cur->group_box == w)
-            a = cur;
-    }
-
+    Association *a = self->find_association(w);
     if (!a)
         return;
 
@@ -938,15 +1576,7 @@ void Main_Component::on_leave_parameter_control(Fl_Widget *w, void *user_data)
 {
     Main_Component *self = (Main_Component *)user_data;
 
-    Association *a = nullptr;
-    for (unsigned i = 0, n = self->assoc_.size(); i < n && !a; ++i) {
-        Association *cur = self->assoc_[i].get();
-        if (cur->value_widget == w)
-            a = cur;
-        else if (cur->group_box == w)
-            a = cur;
-    }
-
+    Association *a = self->find_association(w);
     if (!a)
         return;
 
@@ -978,42 +1608,15 @@ void Main_Component::update_eq_display()
     PA_Integer *peq_gain[3] = {&peq.gain1(), &peq.gain2(), &peq.gain3()};
     PA_Choice *peq_width[3] = {&peq.width1(), &peq.width2(), &peq.width3()};
 
-    auto frequency = [](const std::string &x) -> double {
-                         double v = 0.0;
-                         unsigned count = 0;
-                         if (sscanf_lc(x.c_str(), "%lf%n", "C", &v, &count) != 1) {
-                             assert(false);
-                             abort();
-                         }
-                         if (x.size() > count && x[count] == 'k') {
-                             v *= 1000;
-                             ++count;
-                         }
-                         if (x.size() != count) {
-                             assert(false);
-                             abort();
-                         }
-                         return v;
-                     };
-    auto width = [](const std::string &x) -> double {
-                     double v = 0.0;
-                     unsigned count = 0;
-                     if (sscanf_lc(x.c_str(), "%lf%n", "C", &v, &count) != 1 || x.size() != count) {
-                         assert(false);
-                         abort();
-                     }
-                     return v;
-                 };
-
     for (unsigned i = 0; i < 3; ++i) {
         PA_Choice *pf = peq_frequency[i];
         PA_Integer *pg = peq_gain[i];
         PA_Choice *pw = peq_width[i];
         unsigned idf = pf->clamp(pf->get(pat));
         unsigned idw = pw->clamp(pw->get(pat));
-        bands[i].freq = (idf + 1 == pf->values.size()) ? -1.0 : frequency(pf->values[idf]);
+        bands[i].freq = pf->has_number(idf) ? pf->number(idf) : -1.0;
         bands[i].gain = pow(10.0, 0.05 * pg->get(pat));
-        bands[i].width = width(pw->values[idw]);
+        bands[i].width = pw->number(idw);
     }
 
     d_eq->set_bands(peq_enable, bands, 3);
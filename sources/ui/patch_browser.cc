@@ -0,0 +1,255 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "patch_browser.h"
+#include <FL/Fl.H>
+#include <FL/Fl_Scrollbar.H>
+#include <FL/fl_draw.H>
+#include <algorithm>
+
+Patch_Browser::Patch_Browser(int x, int y, int w, int h, const char *l)
+    : Fl_Group(x, y, w, h, l)
+{
+    // like Fl_Browser, no box stands for the default frame
+    box(FL_NO_BOX);
+    color(FL_BACKGROUND2_COLOR);
+    selection_color(FL_SELECTION_COLOR);
+    align(FL_ALIGN_BOTTOM);
+
+    Fl_Scrollbar *scroll = new Fl_Scrollbar(x, y, Fl::scrollbar_size(), h);
+    scroll_ = scroll;
+    scroll->type(FL_VERTICAL);
+    scroll->linesize(1);
+    scroll->clear_visible_focus();
+    scroll->callback(&on_scroll, this);
+    end();
+
+    resize(x, y, w, h);
+}
+
+static Fl_Boxtype frame_of(Fl_Boxtype box)
+{
+    return box ? box : FL_DOWN_BOX;
+}
+
+void Patch_Browser::draw()
+{
+    Fl_Boxtype frame = frame_of(box());
+    draw_box(frame, color());
+
+    int x = this->x() + Fl::box_dx(frame);
+    int y = this->y() + Fl::box_dy(frame);
+    int w = this->w() - Fl::box_dw(frame) - scroll_->w();
+    int h = this->h() - Fl::box_dh(frame);
+
+    fl_push_clip(x, y, w, h);
+    fl_font(FL_HELVETICA, textsize_);
+
+    int rh = row_height();
+    unsigned end = std::min(size(), top_ + visible_rows() + 1);
+    for (unsigned i = top_; i < end; ++i) {
+        const Row &row = rows_[i];
+        int ry = y + (int)(i - top_) * rh;
+        Fl_Color bg = color();
+        if (row.id == selection_) {
+            bg = selection_color();
+            fl_color(bg);
+            fl_rectf(x, ry, w, rh);
+        }
+        fl_color(fl_contrast(FL_FOREGROUND_COLOR, bg));
+        fl_draw(row.text.c_str(), x + 2, ry, w - 4, rh, FL_ALIGN_LEFT|FL_ALIGN_CLIP);
+    }
+
+    fl_pop_clip();
+    draw_child(*scroll_);
+    draw_label();
+}
+
+int Patch_Browser::handle(int event)
+{
+    switch (event) {
+    case FL_PUSH:
+        if (Fl::event_inside(scroll_))
+            break;
+        if (Fl::visible_focus())
+            take_focus();
+        /* fall through */
+    case FL_DRAG: {
+        if (rows_.empty())
+            return 1;
+        Fl_Boxtype frame = frame_of(box());
+        int dy = Fl::event_y() - (y() + Fl::box_dy(frame));
+        // dragged past the edges, the selection moves by one row and scrolls
+        unsigned index = (dy < 0) ? (top_ ? top_ - 1 : 0) : top_ + dy / row_height();
+        if (event == FL_PUSH && (dy < 0 || index >= size()))
+            return 0; // not on a row, nothing selected and no drag follows
+        index = std::min(index, size() - 1);
+        unsigned old = selection_;
+        select_row(index);
+        if (event == FL_PUSH || selection_ != old)
+            do_callback();
+        return 1;
+    }
+    case FL_RELEASE:
+        return 1;
+    case FL_MOUSEWHEEL: {
+        int top = (int)top_ + 3 * Fl::event_dy();
+        unsigned max_top = size() - std::min(size(), visible_rows());
+        top_ = (unsigned)std::max(0, std::min(top, (int)max_top));
+        update_scrollbar();
+        redraw();
+        return 1;
+    }
+    case FL_FOCUS:
+    case FL_UNFOCUS:
+        return Fl::visible_focus() ? 1 : 0;
+    case FL_KEYBOARD: {
+        if (rows_.empty())
+            break;
+        auto it = find(selection_);
+        int index = (it != rows_.end()) ? (int)(it - rows_.begin()) : -1;
+        int page = std::max(1u, visible_rows());
+        int last = (int)size() - 1;
+        switch (Fl::event_key()) {
+        case FL_Up: index = std::max(0, index - 1); break;
+        case FL_Down: index = std::min(last, index + 1); break;
+        case FL_Page_Up: index = std::max(0, index - page); break;
+        case FL_Page_Down: index = std::min(last, index + page); break;
+        case FL_Home: index = 0; break;
+        case FL_End: index = last; break;
+        default: return Fl_Group::handle(event);
+        }
+        select_row((unsigned)index);
+        do_callback();
+        return 1;
+    }
+    }
+
+    return Fl_Group::handle(event);
+}
+
+void Patch_Browser::resize(int x, int y, int w, int h)
+{
+    Fl_Widget::resize(x, y, w, h);
+
+    Fl_Boxtype frame = frame_of(box());
+    int sw = Fl::scrollbar_size();
+    scroll_->resize(
+        x + w - (Fl::box_dw(frame) - Fl::box_dx(frame)) - sw,
+        y + Fl::box_dy(frame), sw, h - Fl::box_dh(frame));
+    scroll_to(top_);
+}
+
+void Patch_Browser::textsize(Fl_Fontsize size)
+{
+    textsize_ = size;
+    scroll_to(top_);
+    redraw();
+}
+
+void Patch_Browser::clear()
+{
+    rows_.clear();
+    selection_ = ~0u;
+    top_ = 0;
+    update_scrollbar();
+    redraw();
+}
+
+void Patch_Browser::reserve(size_t count)
+{
+    rows_.reserve(count);
+}
+
+void Patch_Browser::add(unsigned id, const char *text)
+{
+    // in-order additions, as when filling the list, append at once
+    if (rows_.empty() || rows_.back().id < id)
+        rows_.push_back(Row{id, text});
+    else {
+        auto it = std::lower_bound(
+            rows_.begin(), rows_.end(), id,
+            [](const Row &row, unsigned id) -> bool { return row.id < id; });
+        if (it->id == id)
+            it->text.assign(text);
+        else
+            rows_.insert(it, Row{id, text});
+    }
+    update_scrollbar();
+    redraw();
+}
+
+void Patch_Browser::remove(unsigned id)
+{
+    auto it = find(id);
+    if (it == rows_.end())
+        return;
+    rows_.erase(it);
+    if (selection_ == id)
+        selection_ = ~0u;
+    scroll_to(top_);
+    redraw();
+}
+
+bool Patch_Browser::contains(unsigned id) const
+{
+    return find(id) != rows_.end();
+}
+
+void Patch_Browser::value(unsigned id)
+{
+    auto it = find(id);
+    if (it == rows_.end())
+        selection_ = ~0u;
+    else
+        select_row(it - rows_.begin());
+    redraw();
+}
+
+std::vector<Patch_Browser::Row>::const_iterator Patch_Browser::find(unsigned id) const
+{
+    auto it = std::lower_bound(
+        rows_.begin(), rows_.end(), id,
+        [](const Row &row, unsigned id) -> bool { return row.id < id; });
+    return (it != rows_.end() && it->id == id) ? it : rows_.end();
+}
+
+unsigned Patch_Browser::visible_rows() const
+{
+    int h = this->h() - Fl::box_dh(frame_of(box()));
+    return (unsigned)std::max(0, h / row_height());
+}
+
+void Patch_Browser::select_row(unsigned index)
+{
+    selection_ = rows_[index].id;
+
+    unsigned visible = std::max(1u, visible_rows());
+    if (index < top_)
+        scroll_to(index);
+    else if (index >= top_ + visible)
+        scroll_to(index - visible + 1);
+    redraw();
+}
+
+void Patch_Browser::scroll_to(unsigned index)
+{
+    unsigned max_top = size() - std::min(size(), visible_rows());
+    top_ = std::min(index, max_top);
+    update_scrollbar();
+}
+
+void Patch_Browser::update_scrollbar()
+{
+    Fl_Scrollbar &scroll = *scroll_;
+    scroll.value((int)top_, (int)visible_rows(), 0, (int)size());
+}
+
+void Patch_Browser::on_scroll(Fl_Widget *w, void *user_data)
+{
+    Patch_Browser *self = (Patch_Browser *)user_data;
+    self->top_ = (unsigned)((Fl_Scrollbar *)w)->value();
+    self->redraw();
+}
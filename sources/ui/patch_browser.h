@@ -0,0 +1,57 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <FL/Fl_Group.H>
+#include <string>
+#include <vector>
+class Fl_Scrollbar;
+
+// list of patches which draws only the rows in view, so the size of the
+// library does not matter; the rows are sorted by id, the patch number
+class Patch_Browser : public Fl_Group {
+public:
+    Patch_Browser(int x, int y, int w, int h, const char *l = nullptr);
+    void draw() override;
+    int handle(int event) override;
+    void resize(int x, int y, int w, int h) override;
+
+    Fl_Fontsize textsize() const { return textsize_; }
+    void textsize(Fl_Fontsize size);
+
+    void clear();
+    void reserve(size_t count);
+    unsigned size() const { return (unsigned)rows_.size(); }
+
+    // adds the row of the id, or replaces its text if present
+    void add(unsigned id, const char *text);
+    void remove(unsigned id);
+    bool contains(unsigned id) const;
+
+    // the selected id, or ~0u if none
+    unsigned value() const { return selection_; }
+    // selects the row of the id and scrolls it into view
+    void value(unsigned id);
+
+private:
+    struct Row {
+        unsigned id;
+        std::string text;
+    };
+
+    std::vector<Row> rows_;
+    unsigned selection_ = ~0u;
+    unsigned top_ = 0;
+    Fl_Fontsize textsize_ = FL_NORMAL_SIZE;
+    Fl_Scrollbar *scroll_ = nullptr;
+
+    std::vector<Row>::const_iterator find(unsigned id) const;
+    int row_height() const { return textsize_ + 4; }
+    unsigned visible_rows() const;
+    void select_row(unsigned index);
+    void scroll_to(unsigned index);
+    void update_scrollbar();
+    static void on_scroll(Fl_Widget *w, void *user_data);
+};
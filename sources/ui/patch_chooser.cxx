@@ -36,7 +36,7 @@ int Patch_Chooser::show(const char *title, const char *text) {
       o->labelsize(12);
       o->callback((Fl_Callback*)cb_OK);
     } // Fl_Button* o
-    { br_bank = new Fl_Hold_Browser(10, 30, 260, 340);
+    { br_bank = new Patch_Browser(10, 30, 260, 340);
       br_bank->box(FL_NO_BOX);
       br_bank->color(FL_BACKGROUND2_COLOR);
       br_bank->selection_color(FL_SELECTION_COLOR);
@@ -47,7 +47,7 @@ int Patch_Chooser::show(const char *title, const char *text) {
       br_bank->textsize(12);
       br_bank->align(Fl_Align(FL_ALIGN_BOTTOM));
       br_bank->when(FL_WHEN_RELEASE_ALWAYS);
-    } // Fl_Hold_Browser* br_bank
+    } // Patch_Browser* br_bank
     { lbl_text = new Fl_Box(10, 7, 260, 13, _("label"));
       lbl_text->labelsize(12);
       lbl_text->align(Fl_Align(FL_ALIGN_LEFT|FL_ALIGN_INSIDE));
@@ -61,22 +61,22 @@ int Patch_Chooser::show(const char *title, const char *text) {
   lbl_text->label(text);
   
   const Patch_Bank &pbank = *pbank_;
+  br_bank->reserve(Patch_Bank::max_count);
   for (unsigned i = 0; i < Patch_Bank::max_count; ++i) {
       std::string name = std::to_string(i + 1) + " - ";
       if (pbank.used[i])
           name += pbank.slot[i].name();
-      br_bank->add(name.c_str(), (void *)(uintptr_t)i);
+      br_bank->add(i, name.c_str());
   }
   
   w->set_modal();
   w->show();
   while (w->shown()) Fl::wait();
-  int v = br_bank->value();
-  void *p = br_bank->data(v);
+  unsigned v = br_bank->value();
   delete w;
   window_ = nullptr;
   if (!accept_)
       return -1;
   
-  return (v == 0) ? -1 : (unsigned)(uintptr_t)p;
+  return (v == ~0u) ? -1 : (int)v;
 }
@@ -3,7 +3,7 @@
 #ifndef patch_chooser_h
 #define patch_chooser_h
 #include <FL/Fl.H>
-#include <FL/Fl_Hold_Browser.H>
+#include "patch_browser.h"
 #include <stdint.h>
 class Patch_Bank;
 #include <FL/Fl_Double_Window.H>
@@ -20,7 +20,7 @@ private:
   inline void cb_OK_i(Fl_Button*, void*);
   static void cb_OK(Fl_Button*, void*);
 public:
-  Fl_Hold_Browser *br_bank;
+  Patch_Browser *br_bank;
   Fl_Box *lbl_text;
 private:
   const Patch_Bank *pbank_ = nullptr; 
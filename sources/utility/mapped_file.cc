@@ -0,0 +1,97 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "mapped_file.h"
+#include <sys/types.h>
+#include <sys/stat.h>
+#if defined(_WIN32)
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
+Mapped_File::~Mapped_File()
+{
+    unmap();
+}
+
+#if !defined(_WIN32)
+bool Mapped_File::map(FILE *fh)
+{
+    unmap();
+
+    int fd = fileno(fh);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    size_t size = st.st_size;
+    if (size == 0)
+        return true;
+
+    void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+        return false;
+#if defined(POSIX_MADV_SEQUENTIAL)
+    posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+#endif
+
+    data_ = (const uint8_t *)data;
+    size_ = size;
+    return true;
+}
+
+void Mapped_File::unmap()
+{
+    if (data_)
+        munmap((void *)data_, size_);
+    data_ = nullptr;
+    size_ = 0;
+}
+#else
+bool Mapped_File::map(FILE *fh)
+{
+    unmap();
+
+    HANDLE file = (HANDLE)_get_osfhandle(fileno(fh));
+    if (file == INVALID_HANDLE_VALUE || GetFileType(file) != FILE_TYPE_DISK)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+        return false;
+    if (size.QuadPart == 0)
+        return true;
+    if ((unsigned long long)size.QuadPart > (size_t)-1)
+        return false;
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+        return false;
+
+    void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    data_ = (const uint8_t *)data;
+    size_ = (size_t)size.QuadPart;
+    mapping_ = mapping;
+    return true;
+}
+
+void Mapped_File::unmap()
+{
+    if (data_)
+        UnmapViewOfFile(data_);
+    if (mapping_)
+        CloseHandle((HANDLE)mapping_);
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+}
+#endif
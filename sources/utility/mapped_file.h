@@ -0,0 +1,33 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// read-only memory mapping of a whole file
+class Mapped_File {
+public:
+    Mapped_File() {}
+    ~Mapped_File();
+
+    Mapped_File(const Mapped_File &) = delete;
+    Mapped_File &operator=(const Mapped_File &) = delete;
+
+    // fails if the file is not a regular file, eg. a pipe
+    bool map(FILE *fh);
+    void unmap();
+
+    const uint8_t *data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    void *mapping_ = nullptr;
+#endif
+};
@@ -4,6 +4,17 @@
 //          http://www.boost.org/LICENSE_1_0.txt)
 
 #include "misc.h"
+#include <FL/filename.H>
+#include <FL/fl_utf8.h>
+#if defined(_WIN32)
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#endif
+#include <atomic>
 
 bool starts_with(const char *x, const char *s)
 {
@@ -32,6 +43,118 @@ bool read_entire_file(FILE *fh, size_t max_size, std::vector<uint8_t> &data)
     return fread(data.data(), 1, size, fh) == size;
 }
 
+bool sync_file(FILE *fh)
+{
+    if (fflush(fh) != 0)
+        return false;
+#if defined(_WIN32)
+    return _commit(_fileno(fh)) == 0;
+#else
+    return fsync(fileno(fh)) == 0;
+#endif
+}
+
+bool truncate_file(FILE *fh, uint64_t size)
+{
+    if (fflush(fh) != 0)
+        return false;
+#if defined(_WIN32)
+    return _chsize_s(_fileno(fh), (__int64)size) == 0;
+#else
+    return ftruncate(fileno(fh), (off_t)size) == 0;
+#endif
+}
+
+bool lock_file(FILE *fh)
+{
+#if defined(_WIN32)
+    HANDLE file = (HANDLE)_get_osfhandle(_fileno(fh));
+    OVERLAPPED ov = {};
+    return file != INVALID_HANDLE_VALUE &&
+        LockFileEx(file, LOCKFILE_EXCLUSIVE_LOCK|LOCKFILE_FAIL_IMMEDIATELY, 0, 1, 0, &ov);
+#else
+    return flock(fileno(fh), LOCK_EX|LOCK_NB) == 0;
+#endif
+}
+
+#if defined(_WIN32)
+static std::wstring utf8_to_wide(const std::string &str)
+{
+    int length = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, nullptr, 0);
+    if (length <= 0)
+        return std::wstring();
+    std::wstring wstr(length, L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, str.c_str(), -1, &wstr[0], length);
+    wstr.resize(length - 1);
+    return wstr;
+}
+#endif
+
+static bool replace_file(const std::string &src, const std::string &dst)
+{
+#if defined(_WIN32)
+    return MoveFileExW(utf8_to_wide(src).c_str(), utf8_to_wide(dst).c_str(),
+                       MOVEFILE_REPLACE_EXISTING|MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(src.c_str(), dst.c_str()) == 0;
+#endif
+}
+
+bool sync_file_directory(const std::string &filename)
+{
+#if defined(_WIN32)
+    // the moves are written through, and directories cannot be synced
+    (void)filename;
+    return true;
+#else
+    size_t slash = filename.rfind('/');
+    std::string dirname = (slash == std::string::npos) ? std::string(".") :
+        (slash == 0) ? std::string("/") : filename.substr(0, slash);
+    int fd = open(dirname.c_str(), O_RDONLY);
+    if (fd == -1)
+        return false;
+    bool success = fsync(fd) == 0;
+    return close(fd) == 0 && success;
+#endif
+}
+
+static FILE *create_temporary_file(const std::string &filename, std::string &tempname)
+{
+    // a name of its own, in the directory of the file, never an existing one
+    static std::atomic<unsigned> counter{0};
+#if defined(_WIN32)
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = (unsigned long)getpid();
+#endif
+    for (unsigned attempt = 0; attempt < 100; ++attempt) {
+        tempname = filename + "." + std::to_string(pid) + "-" + std::to_string(counter++) + ".tmp";
+        if (FILE *fh = fl_fopen(tempname.c_str(), "wbx"))
+            return fh;
+    }
+    return nullptr;
+}
+
+bool write_file_atomically(const std::string &filename, const uint8_t *data, size_t size)
+{
+    // write a temporary file next to it, then replace in a single step
+    std::string tempname;
+    FILE_u fh(create_temporary_file(filename, tempname));
+    if (!fh)
+        return false;
+
+    bool success = fwrite(data, 1, size, fh.get()) == size && sync_file(fh.get());
+    success = fclose(fh.release()) == 0 && success;
+    success = success && replace_file(tempname, filename);
+    if (!success) {
+        fl_unlink(tempname.c_str());
+        return false;
+    }
+
+    // the replacement is durable once the directory is
+    return sync_file_directory(filename);
+}
+
 std::string file_name_extension(const std::string &fn)
 {
     size_t n = fn.size();
@@ -54,3 +177,45 @@ std::string file_name_without_extension(const std::string &fn)
     std::string ext = file_name_extension(fn);
     return fn.substr(0, fn.size() - ext.size());
 }
+
+static bool list_files(const std::string &dirname, std::vector<std::string> &filenames, unsigned depth, unsigned max_depth)
+{
+    if (depth > max_depth)
+        return true;
+
+    dirent **list = nullptr;
+    int count = fl_filename_list(dirname.c_str(), &list, fl_numericsort);
+    if (count < 0)
+        return false;
+
+    std::string prefix = dirname;
+    if (!prefix.empty() && prefix.back() != '/')
+        prefix.push_back('/');
+
+    for (int i = 0; i < count; ++i) {
+        const char *name = list[i]->d_name;
+        if (!strcmp(name, "./") || !strcmp(name, "../") || !strcmp(name, ".") || !strcmp(name, ".."))
+            continue;
+
+        // an unreadable subdirectory is skipped, only the root must be listed
+        size_t length = strlen(name);
+        if (length > 0 && name[length - 1] == '/')
+            list_files(prefix + name, filenames, depth + 1, max_depth);
+        else
+            filenames.push_back(prefix + name);
+    }
+
+    fl_filename_free_list(&list, count);
+    return true;
+}
+
+bool list_files(const std::string &dirname, std::vector<std::string> &filenames)
+{
+    return list_files(dirname, filenames, 0, 0);
+}
+
+bool list_files_recursively(const std::string &dirname, std::vector<std::string> &filenames)
+{
+    // bound the depth, in case of a cycle of links
+    return list_files(dirname, filenames, 0, 64);
+}
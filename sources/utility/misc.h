@@ -27,6 +27,49 @@ bool ends_with(const char *x, const char *s);
 // whole file I/O
 bool read_entire_file(FILE *fh, size_t max_size, std::vector<uint8_t> &data);
 
+// durable file writes
+bool sync_file(FILE *fh);
+// makes the creation, removal or renaming of a file durable
+bool sync_file_directory(const std::string &filename);
+bool write_file_atomically(const std::string &filename, const uint8_t *data, size_t size);
+
+// cuts an open file to a size, after flushing it
+bool truncate_file(FILE *fh, uint64_t size);
+
+// exclusive lock of an open file, without waiting, until it is closed
+bool lock_file(FILE *fh);
+
 // file names
 std::string file_name_extension(const std::string &fn);
 std::string file_name_without_extension(const std::string &fn);
+
+// directory listing, in a deterministic order.
+// fails only if the directory itself cannot be read.
+bool list_files(const std::string &dirname, std::vector<std::string> &filenames);
+bool list_files_recursively(const std::string &dirname, std::vector<std::string> &filenames);
+
+// little-endian integers
+inline uint32_t load_u32le(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+        ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+inline uint64_t load_u64le(const uint8_t *p)
+{
+    return (uint64_t)load_u32le(p) | ((uint64_t)load_u32le(p + 4) << 32);
+}
+
+inline void store_u32le(uint8_t *p, uint32_t x)
+{
+    p[0] = x & 0xff;
+    p[1] = (x >> 8) & 0xff;
+    p[2] = (x >> 16) & 0xff;
+    p[3] = x >> 24;
+}
+
+inline void store_u64le(uint8_t *p, uint64_t x)
+{
+    store_u32le(p, (uint32_t)x);
+    store_u32le(p + 4, (uint32_t)(x >> 32));
+}
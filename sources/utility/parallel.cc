@@ -0,0 +1,60 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#include "parallel.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <chrono>
+
+static constexpr std::chrono::milliseconds progress_interval(50);
+
+void parallel_for(size_t count, const std::function<void(size_t)> &fn,
+                  const std::function<void(size_t)> &progress)
+{
+    if (count == 0)
+        return;
+
+    size_t num_threads = std::thread::hardware_concurrency();
+    num_threads = (num_threads > 0) ? num_threads : 1;
+    num_threads = (num_threads < count) ? num_threads : count;
+
+    std::atomic<size_t> next_index(0);
+    std::mutex done_mutex;
+    std::condition_variable done_cond;
+    size_t done_count = 0;
+
+    auto work = [&]() {
+                    size_t index;
+                    while ((index = next_index.fetch_add(1)) < count) {
+                        fn(index);
+                        std::lock_guard<std::mutex> lock(done_mutex);
+                        if (++done_count == count)
+                            done_cond.notify_one();
+                    }
+                };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i)
+        threads.emplace_back(work);
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    while (done_count < count) {
+        done_cond.wait_for(lock, progress_interval);
+        if (progress) {
+            size_t done = done_count;
+            lock.unlock();
+            progress(done);
+            lock.lock();
+        }
+    }
+    lock.unlock();
+
+    for (std::thread &thread : threads)
+        thread.join();
+}
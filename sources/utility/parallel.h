@@ -0,0 +1,13 @@
+//          Copyright Jean Pierre Cimalando 2018.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+#include <functional>
+#include <stddef.h>
+
+// runs fn(0) ... fn(count - 1) on a pool of worker threads, while the calling
+// thread periodically reports the count of finished items to progress
+void parallel_for(size_t count, const std::function<void(size_t)> &fn,
+                  const std::function<void(size_t)> &progress = nullptr);